@@ -0,0 +1,32 @@
+#!/bin/sh
+################################################################################
+#   materials.sh
+#
+#   Speed-up of compacted property tables. The same '--bench' workload runs
+# with materials/mCP.mat as it is, and with 'compact off'. Steps/s of both
+# are printed, and both are checked against the reference, since compacting
+# must not change any photon count. Run it in the build directory.
+#
+#                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+################################################################################
+
+MCP=${MCP:-./mCP}
+SEED=${SEED:-12345}
+WORKLOAD=${WORKLOAD:-mu1GeV}
+MAT=${MAT:-materials/mCP.mat}
+
+RAW=$(mktemp)
+trap 'rm -f ${RAW}' EXIT
+sed 's/^compact on/compact off/' ${MAT} > ${RAW}
+
+for LABEL in raw compacted; do
+	M=${MAT}
+	[ ${LABEL} = raw ] && M=${RAW}
+	${MCP} --bench ${WORKLOAD} --materials ${M} --seed ${SEED} --output summary | grep '^{"bench"' | awk -v L=${LABEL} '
+	function num(key,    s) { s = $0; if ( !sub(".*\"" key "\": ", "", s) ) return "-"; sub("[,}].*", "", s); return s }
+	{
+		s = $0; sub(".*\"check\": \"", "", s); sub("\".*", "", s)
+		printf "%-10s %12s steps/s %12s photons/s, check %s\n", L, num("steps_per_s"), num("photons_per_s"), s
+	}'
+done
+rm -f mCP_*.sum
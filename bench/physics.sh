@@ -0,0 +1,33 @@
+#!/bin/sh
+################################################################################
+#   physics.sh
+#
+#   Comparison of '--physics full', 'em4' and 'em0' on the '--bench'
+# workloads: initialization time, peak memory, time per event, and the photon
+# counts against the reference of the full list. A pull above 5 means that
+# the light list changes the physics of that workload. Run it in the build
+# directory.
+#
+#                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+################################################################################
+
+MCP=${MCP:-./mCP}
+SEED=${SEED:-12345}
+OPTICS=${OPTICS:-full}
+WORKLOADS=${WORKLOADS:-"mu1GeV mu100MeV mu1GeVAngled"}
+
+printf "%-14s %-5s %8s %8s %10s %10s %8s %8s %s\n" workload list init_s RSS_MB ms/event photons/s pScint pCeren check
+for W in ${WORKLOADS}; do
+	for P in full em4 em0; do
+		${MCP} --bench ${W} --physics ${P} --optics ${OPTICS} --seed ${SEED} --output summary | grep '^{"bench"' | awk -v W=${W} -v P=${P} '
+		function num(key,    s) { s = $0; if ( !sub(".*\"" key "\": ", "", s) ) return "-"; sub("[,}].*", "", s); return s }
+		function pull(key,    s) { s = $0; if ( !sub(".*\"" key "\": {[^}]*\"pull\": ", "", s) ) return "-"; sub("}.*", "", s); return s }
+		{
+			eps = num("events_per_s")
+			s = $0; sub(".*\"check\": \"", "", s); sub("\".*", "", s)
+			printf "%-14s %-5s %8s %8s %10.3g %10s %8s %8s %s\n", W, P, num("initTime_s"), num("peakRSS_MB"),
+			       (eps > 0 ? 1000. / eps : 0), num("photons_per_s"), pull("nScint"), pull("nCeren"), s
+		}'
+	done
+done
+rm -f mCP_*.sum
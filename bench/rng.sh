@@ -0,0 +1,19 @@
+#!/bin/sh
+################################################################################
+#   rng.sh
+#
+#   Events/s of every random engine on the standard muon setup, with a fixed
+# seed. Run it in the build directory.
+#
+#                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+################################################################################
+
+MCP=${MCP:-./mCP}
+SEED=${SEED:-12345}
+
+printf "%-10s %s\n" "engine" "events/s"
+for RNG in ranlux:4 ranlux:3 ranlux:1 ranlux:0 mixmax mt
+do
+	RATE=$(${MCP} -b -m bench/rng.mac --rng ${RNG} --seed ${SEED} | grep "events/s" | tail -n 1 | sed 's/.*(\([0-9.e+-]*\) events\/s.*/\1/')
+	printf "%-10s %s\n" "${RNG}" "${RATE}"
+done
@@ -0,0 +1,72 @@
+#!/bin/sh
+################################################################################
+#   suite.sh
+#
+#   Benchmark suite: every '--bench' workload in every optics mode, fixed
+# seed. Results go to bench_results.json, one object per run. A run whose
+# photon counts are off the reference, or that has no reference at all,
+# fails the suite. Run it in the build directory, or through the mCP_bench
+# target, which CMake only makes when bench/reference.txt has rows.
+#
+#   sh bench/suite.sh           # Run and check
+#   sh bench/suite.sh --update  # Run and rewrite bench/reference.txt
+#
+#   PHYCACHE=dir sh bench/suite.sh  # Physics tables from '--physics-cache'
+#
+#   Note that the build directory has its own copy of reference.txt. Copy an
+# updated one back to the source tree.
+#
+#                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+################################################################################
+
+MCP=${MCP:-./mCP}
+SEED=${SEED:-12345}
+WORKLOADS=${WORKLOADS:-"mu1GeV mu100MeV mu1GeVAngled"}
+RESULTS=${RESULTS:-bench_results.json}
+REF=bench/reference.txt
+
+# calib makes the map that fast uses, so it comes first.
+MAPDIR=$(mktemp -d)
+trap 'rm -rf ${MAPDIR}' EXIT
+OPTICS="full yield calib fast"
+
+STATUS=0
+LOG=${MAPDIR}/log
+: > ${MAPDIR}/json
+: > ${MAPDIR}/ref
+# Summary output: disk speed is not what is measured here.
+for W in ${WORKLOADS}; do
+	for O in ${OPTICS}; do
+		${MCP} --bench ${W} --optics ${O} --map-dir ${MAPDIR} --seed ${SEED} --output summary --bench-ref ${REF} ${PHYCACHE:+--physics-cache ${PHYCACHE}} > ${LOG} 2>&1
+		RC=$?
+		if ! grep -q '^{"bench"' ${LOG}; then
+			echo "${W} ${O}: no result (exit ${RC})"
+			tail -n 20 ${LOG}
+			STATUS=1
+			continue
+		fi
+		grep '^{"bench"' ${LOG} >> ${MAPDIR}/json
+		grep '^mCP-bench-ref:' ${LOG} | cut -d' ' -f2- >> ${MAPDIR}/ref
+		grep '^{"bench"' ${LOG} | sed 's/.*"events_per_s": \([^,]*\).*"check": "\([a-z]*\)".*/\1 events\/s, check \2/' | sed "s/^/${W} ${O}: /"
+		[ ${RC} -eq 0 ] || STATUS=1
+		# Nothing to check against is a failure too, unless it is being made.
+		if [ "$1" != "--update" ] && grep -q '^{"bench".*"check": "none"' ${LOG}; then
+			echo "${W} ${O}: no reference in ${REF}. Run 'sh bench/suite.sh --update' on a trusted build."
+			STATUS=1
+		fi
+	done
+done
+rm -f mCP_*.sum
+
+# JSON array
+awk 'BEGIN { print "[" } { printf "%s%s\n", (NR > 1 ? "," : ""), $0 } END { print "]" }' ${MAPDIR}/json > ${RESULTS}
+echo "Results in ${RESULTS}"
+
+if [ "$1" = "--update" ]; then
+	grep '^#' ${REF} > ${MAPDIR}/header
+	cat ${MAPDIR}/header ${MAPDIR}/ref > ${REF}
+	echo "Reference values written to ${REF}"
+	exit 0
+fi
+
+exit ${STATUS}
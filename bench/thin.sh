@@ -0,0 +1,44 @@
+#!/bin/sh
+################################################################################
+#   thin.sh
+#
+#   Validation of '--thin' against tracking every photon. Photons are
+# tracked to the photosensors, once with p = 1 and once with p = KEEP. The
+# weighted means per event (nScint, nCeren, and photons at each end) are
+# compared, and a pull above 3 fails. Time per event is printed for both.
+# Run it in the build directory.
+#
+#                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+################################################################################
+
+MCP=${MCP:-./mCP}
+SEED=${SEED:-12345}
+KEEP=${KEEP:-0.1}
+
+FULL=$(${MCP} -b -m bench/thin.mac --seed ${SEED} --sensors --thin 1       --output summary | grep -e "mCP: weighted" -e "ms/event" | tail -n 2)
+THIN=$(${MCP} -b -m bench/thin.mac --seed ${SEED} --sensors --thin ${KEEP} --output summary | grep -e "mCP: weighted" -e "ms/event" | tail -n 2)
+rm -f mCP_*.sum
+echo "p = 1    : ${FULL}"
+echo "p = ${KEEP} : ${THIN}"
+
+# "mCP: N events, S steps in T s (R events/s, M ms/event, ...)"
+# "mCP: weighted nScint M +- E, nCeren M +- E, nEndPz M +- E, nEndMz M +- E per event"
+printf "%s\n%s\n" "${FULL}" "${THIN}" | awk '
+BEGIN { nt = 0; nw = 0 }
+/ms\/event/ { for ( i = 1; i < NF; i++ ) if ( $(i + 1) == "ms/event," ) ms[nt++] = $i }
+/weighted/  {
+	for ( k = 0; k < 4; k++ ) { m[nw, k] = $(4 + 4 * k); e[nw, k] = $(6 + 4 * k); sub(",", "", e[nw, k]) }
+	nw++
+}
+END {
+	split("nScint nCeren nEndPz nEndMz", name, " ")
+	fail = 0
+	for ( k = 0; k < 4; k++ )
+	{
+		p = (m[0, k] - m[1, k]) / sqrt(e[0, k] * e[0, k] + e[1, k] * e[1, k] + 1e-30)
+		printf "pull : %-7s %6.2f\n", name[k + 1], p
+		if ( p > 3 || p < -3 ) fail = 1
+	}
+	if ( ms[1] > 0 ) printf "time : %s ms/event -> %s ms/event (x%.1f faster)\n", ms[0], ms[1], ms[0] / ms[1]
+	exit fail
+}'
@@ -0,0 +1,50 @@
+#!/bin/sh
+################################################################################
+#   trace.sh
+#
+#   Validation and throughput of '--optics trace' against full tracking.
+# '--optics calib' tracks every photon to the ends of the bar and makes the
+# surface table, with seed SEED. '--optics trace' then runs with another
+# seed. Photons per event at each end are compared, and a pull above 3
+# fails. Time per event of both, and photons per second of the tracer, are
+# printed. Maps go to a temporary directory. Run it in the build directory.
+#
+#                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+################################################################################
+
+MCP=${MCP:-./mCP}
+SEED=${SEED:-12345}
+DIR=$(mktemp -d)
+
+FULL=$(${MCP} -b -m bench/trace.mac --seed ${SEED}       --optics calib --map-dir ${DIR} --output summary | grep -e "mCP: nDetPz" -e "ms/event" | tail -n 2)
+TRAC=$(${MCP} -b -m bench/trace.mac --seed $((SEED + 1)) --optics trace --map-dir ${DIR} --output summary | grep -e "mCP: nDetPz" -e "ms/event" -e "box tracer" | tail -n 3)
+rm -rf ${DIR}
+rm -f mCP_*.sum
+echo "full  : ${FULL}"
+echo "trace : ${TRAC}"
+
+# "mCP: N events, S steps in T s (R events/s, M ms/event, ...)"
+# "mCP: nDetPz M +- E, nDetMz M +- E per event"
+# "mCP: box tracer N photons, H side face hits in T s (P photons/s, Q hits/s)"
+printf "%s\n%s\n" "${FULL}" "${TRAC}" | awk '
+BEGIN { nt = 0; nd = 0; rate = "" }
+/ms\/event/  { for ( i = 1; i < NF; i++ ) if ( $(i + 1) == "ms/event," ) ms[nt++] = $i }
+/box tracer/ { for ( i = 1; i < NF; i++ ) if ( $(i + 1) == "photons/s," ) { rate = $i; sub("\\(", "", rate) } }
+/nDetPz/     {
+	for ( k = 0; k < 2; k++ ) { m[nd, k] = $(3 + 4 * k); e[nd, k] = $(5 + 4 * k); sub(",", "", e[nd, k]) }
+	nd++
+}
+END {
+	if ( nd < 2 ) { print "missing results"; exit 1 }
+	split("nDetPz nDetMz", name, " ")
+	fail = 0
+	for ( k = 0; k < 2; k++ )
+	{
+		p = (m[0, k] - m[1, k]) / sqrt(e[0, k] * e[0, k] + e[1, k] * e[1, k] + 1e-30)
+		printf "pull : %-7s %8s vs %8s  %6.2f\n", name[k + 1], m[0, k], m[1, k], p
+		if ( p > 3 || p < -3 ) fail = 1
+	}
+	if ( ms[1] > 0 ) printf "time : %s ms/event -> %s ms/event (x%.1f faster)\n", ms[0], ms[1], ms[0] / ms[1]
+	if ( rate != "" ) printf "rate : %s photons/s in the tracer\n", rate
+	exit fail
+}'
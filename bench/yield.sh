@@ -0,0 +1,29 @@
+#!/bin/sh
+################################################################################
+#   yield.sh
+#
+#   Validation of '--optics yield' against full photon generation. Same
+# seed, photon counts per event compared by their means. A pull
+# above 3 fails. Run it in the build directory.
+#
+#                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+################################################################################
+
+MCP=${MCP:-./mCP}
+SEED=${SEED:-12345}
+
+FULL=$(${MCP} -b -m bench/yield.mac --seed ${SEED} --optics full  | grep "mCP: nScint" | tail -n 1)
+YIEL=$(${MCP} -b -m bench/yield.mac --seed ${SEED} --optics yield | grep "mCP: nScint" | tail -n 1)
+echo "full : ${FULL}"
+echo "yield: ${YIEL}"
+
+# "mCP: nScint M +- E, nCeren M +- E per event (N events)"
+echo "${FULL} ${YIEL}" | awk '
+{
+	fs = $3; fse = $5; fc = $7; fce = $9; sub(",", "", fse)
+	ys = $16; yse = $18; yc = $20; yce = $22; sub(",", "", yse)
+	ps = (fs - ys) / sqrt(fse * fse + yse * yse + 1e-30)
+	pc = (fc - yc) / sqrt(fce * fce + yce * yce + 1e-30)
+	printf "pull : nScint %.2f, nCeren %.2f\n", ps, pc
+	exit (ps > 3 || ps < -3 || pc > 3 || pc < -3) ? 1 : 0
+}'
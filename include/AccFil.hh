@@ -0,0 +1,86 @@
+#ifndef ACCFIL_h
+#define ACCFIL_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   AccFil.hh
+//
+//   This file is a header for AccFil class. It is the acceptance filter of
+// '--acceptance': optical photons made in a step are looked at together,
+// before any of them is tracked, and the ones which can hardly reach an end
+// of the bar are killed or weighted down.
+//
+//   For a polished bar, reflections on the side faces keep |dx|, |dy| and
+// |dz| of a photon. So its path to the end ahead of it and the number of times
+// it meets each pair of side faces are known at creation. An upper bound of
+// its chance to get there is then
+//   U = exp(-path / ABSLENGTH) * Rs(x)^(hits on x faces) * Rs(y)^(...),
+// with the s-polarized Fresnel reflectance Rs >= Rp, and 1 under total
+// internal reflection. Scattering, rough or wrapped surfaces break this, so
+// the filter turns itself off for them.
+//
+//   'exact' keeps a photon with U < threshold with probability U/threshold
+// and weight threshold/U: weighted counts are unbiased. 'cut' kills it, and
+// the sum of U over killed photons (accLost) bounds the photons lost at the
+// ends. Killed photons are still counted in nScint and nCeren.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4MaterialPropertyVector.hh"
+
+class EveAct;
+class G4Step;
+class G4Track;
+class G4VPhysicalVolume;
+class G4ParticleDefinition;
+
+class AccFil
+{
+  public:
+	enum Mode { kOff = 0, kExact, kCut };
+
+	AccFil(EveAct* EA);
+	~AccFil();
+
+	// Process-wide settings and columns, set in main()
+	static void Configure(Mode mode, G4double threshold);
+	static Mode GetMode();
+
+	// Geometry and materials of the bar. Call at the beginning of every run.
+	void BeginOfRun();
+
+	// Photons made in this step
+	void Filter(const G4Step* step);
+
+  private:
+	// Bounds of the first n photons of the batch
+	void ComputeBounds(std::size_t n);
+
+  private:
+	EveAct* m_EA;
+	G4bool m_Active;
+
+	// Bar: center, half lengths, and optical properties inside and outside
+	const G4VPhysicalVolume* m_SciPV;
+	G4ThreeVector m_Center;
+	G4double m_Half[3];
+	const G4MaterialPropertyVector* m_RIndex;
+	const G4MaterialPropertyVector* m_AbsLength;
+	const G4MaterialPropertyVector* m_OutRIndex;
+	const G4ParticleDefinition* m_OptPho;
+
+	// Batch of photons of a step, as structure of arrays
+	std::vector<G4Track*> m_Tracks;
+	std::vector<G4double> m_Pos[3], m_Dir[3];
+	std::vector<G4double> m_N, m_NOut, m_AbsLen;
+	std::vector<G4double> m_Path, m_U, m_Rand;
+
+	static Mode s_Mode;
+	static G4double s_Threshold;
+};
+
+#endif
@@ -22,7 +22,19 @@ class ActIni: public G4VUserActionInitialization
 	virtual void BuildForMaster() const;
 	virtual void Build() const;
 
+	// Pin every worker thread to its own core
+	void SetPinAffinity(G4bool pin);
+
+	// Sub-event parallel mode: the master runs events, workers run photons
+	void SetSubEvent(G4bool subEvent);
+
+  private:
+	void BuildActions(G4bool isWorker) const;
+	void PinThisThread() const;
+
   private:
+	G4bool m_Pin;
+	G4bool m_SubEvent;
 };
 
 #endif
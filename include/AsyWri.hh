@@ -0,0 +1,55 @@
+#ifndef ASYWRI_h
+#define ASYWRI_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   AsyWri.hh
+//
+//   This file is a header for AsyWri class. It is the writer thread of
+// columnar output ('--async N'). Event threads hand over full batches of rows
+// through a lock-free queue and go on filling a spare one, while this thread
+// packs and writes them. There are N spare batches: when all of them are in
+// flight, an event thread waits for one to come back, so memory stays
+// bounded by N plus one batch per thread.
+//
+//   Every block is flushed to the file as soon as it is written, so a crash
+// never loses the blocks before it. It loses what is not written yet: up to
+// N full batches in flight, and the batch each thread is filling. '--async 2'
+// keeps that smallest.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <vector>
+
+#include "globals.hh"
+
+class ColWri;
+struct ColBat;
+
+class AsyWri
+{
+  public:
+	// main() sets the number of batches in flight. The thread itself starts
+	// with the first batch, so forked shards each get their own.
+	static void Enable(G4int nBatches);
+	static G4bool IsEnabled();
+
+	// Event threads: a spare batch (waits if none, null after Stop()), and a
+	// full batch for the writer. The last batch of a file is the writer's to
+	// delete.
+	static ColBat* Acquire(const std::vector<char>& types);
+	static void Submit(ColWri* CW, ColBat* batch, G4bool last = false);
+
+	// Until counter goes to zero
+	static void Wait(const std::atomic<G4int>& counter);
+
+	// main(), at the very end: write what is left and join.
+	static void Stop();
+
+  private:
+	static void Start();
+	static void Loop();
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef BATQUE_h
+#define BATQUE_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   BatQue.hh
+//
+//   This file is a header for BatQue class template: a bounded lock-free
+// queue of pointers for any number of producers and consumers (D. Vyukov's
+// bounded MPMC queue). Push and Pop never block; they fail when the queue is
+// full or empty. PushWait and PopWait sleep on a condition variable instead,
+// which every successful Push and Pop signals.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+template <class T>
+class BatQue
+{
+  public:
+	// Capacity is rounded up to a power of two.
+	explicit BatQue(std::size_t capacity);
+
+	bool Push(T* item);
+	bool Pop(T*& item);
+
+	// Until there is room, or until there is an item or stop is set. PopWait
+	// returns false on stop with the queue empty.
+	void PushWait(T* item);
+	bool PopWait(T*& item, const std::atomic<bool>& stop);
+
+	// Wakes every waiter, to see a stop flag
+	void Wake();
+
+  private:
+	// Push and Pop without the signal
+	bool TryPush(T* item);
+	bool TryPop(T*& item);
+
+  private:
+	struct Cell
+	{
+		std::atomic<std::size_t> seq;
+		T* item;
+	};
+
+	std::vector<Cell> m_Cells;
+	std::size_t m_Mask;
+
+	// Apart, so producers and consumers do not share a cache line
+	alignas(64) std::atomic<std::size_t> m_Head;
+	alignas(64) std::atomic<std::size_t> m_Tail;
+
+	// Only for waiters. Items are big, so one lock per item costs nothing.
+	std::mutex m_Mutex;
+	std::condition_variable m_Cond;
+};
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+template <class T>
+BatQue<T>::BatQue(std::size_t capacity): m_Head(0), m_Tail(0)
+{
+	std::size_t size = 2;
+	while ( size < capacity ) size <<= 1;
+
+	m_Cells = std::vector<Cell>(size);
+	for ( std::size_t i = 0; i < size; i++ ) m_Cells[i].seq.store(i, std::memory_order_relaxed);
+	m_Mask = size - 1;
+}
+
+//////////////////////////////////////////////////
+//   Push and pop
+//////////////////////////////////////////////////
+template <class T>
+bool BatQue<T>::Push(T* item)
+{
+	if ( !TryPush(item) ) return false;
+	Wake();
+	return true;
+}
+
+template <class T>
+bool BatQue<T>::Pop(T*& item)
+{
+	if ( !TryPop(item) ) return false;
+	Wake();
+	return true;
+}
+
+template <class T>
+bool BatQue<T>::TryPush(T* item)
+{
+	std::size_t pos = m_Tail.load(std::memory_order_relaxed);
+	for ( ;; )
+	{
+		Cell& cell = m_Cells[pos & m_Mask];
+		std::size_t seq = cell.seq.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+		if ( diff == 0 )
+		{
+			if ( m_Tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+			{
+				cell.item = item;
+				cell.seq.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if ( diff < 0 ) return false; // Full
+		else pos = m_Tail.load(std::memory_order_relaxed);
+	}
+}
+
+template <class T>
+bool BatQue<T>::TryPop(T*& item)
+{
+	std::size_t pos = m_Head.load(std::memory_order_relaxed);
+	for ( ;; )
+	{
+		Cell& cell = m_Cells[pos & m_Mask];
+		std::size_t seq = cell.seq.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+		if ( diff == 0 )
+		{
+			if ( m_Head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+			{
+				item = cell.item;
+				cell.seq.store(pos + m_Mask + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if ( diff < 0 ) return false; // Empty
+		else pos = m_Head.load(std::memory_order_relaxed);
+	}
+}
+
+//////////////////////////////////////////////////
+//   Wait and wake
+//////////////////////////////////////////////////
+template <class T>
+void BatQue<T>::PushWait(T* item)
+{
+	if ( Push(item) ) return;
+
+	// The condition is checked with the lock held, and Wake() takes it, so
+	// a change in between is not missed.
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_Cond.wait(lock, [&] { return TryPush(item); });
+	lock.unlock();
+	Wake();
+}
+
+template <class T>
+bool BatQue<T>::PopWait(T*& item, const std::atomic<bool>& stop)
+{
+	if ( Pop(item) ) return true;
+
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	bool popped = false;
+	m_Cond.wait(lock, [&] { popped = TryPop(item); return popped || stop.load(); });
+	lock.unlock();
+	if ( popped ) Wake();
+	return popped;
+}
+
+template <class T>
+void BatQue<T>::Wake()
+{
+	{ std::lock_guard<std::mutex> lock(m_Mutex); }
+	m_Cond.notify_all();
+}
+
+#endif
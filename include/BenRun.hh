@@ -0,0 +1,36 @@
+#ifndef BENRUN_h
+#define BENRUN_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   BenRun.hh
+//
+//   This file is a header for BenRun class. It runs one of the fixed
+// reference workloads of '--bench' and prints its result as one line of JSON:
+// throughput, initialization time, peak memory, and nScint/nCeren means
+// checked against bench/reference.txt, so that a speed-up which changes the
+// physics does not go unnoticed.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "globals.hh"
+
+class BenRun
+{
+  public:
+	static G4bool Has(const G4String& workload);
+	static void PrintWorkloads();
+
+	// Runs the workload in the current (sequential) run manager. Returns 0,
+	// or 2 if the photon counts disagree with the reference.
+	static G4int Run(const G4String& workload, const G4String& physics, const G4String& optics, G4long seed,
+	                 G4double initTime, const G4String& physicsTables, const G4String& refFile);
+
+  private:
+	// Reference means and errors of a workload in an optics mode. False if
+	// there is none.
+	static G4bool FindReference(const G4String& refFile, const G4String& workload, const G4String& optics,
+	                            G4double ref[4]);
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef BOXTRA_h
+#define BOXTRA_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   BoxTra.hh
+//
+//   This file is a header for BoxTra class. It is the optical photon tracer
+// of '--optics trace'. The bar is a box, so the next face of a photon is the
+// nearest of three planes, and Geant4 navigation is not needed at all.
+//
+//   StaAct hands it the optical photons made in the bar instead of stacking
+// them. They are kept as structure of arrays and traced in batches: each
+// round moves every photon of the batch to its next face, where it is
+// absorbed on the way (ABSLENGTH), arrives at an end, or meets a side face.
+// What a side face does comes from SurTab, which is counted from full
+// tracking. Arrivals go to EveAct as in '--optics fast', at the creation
+// time plus the path over the group velocity.
+//
+//   Rayleigh scattering and wavelength shifting are not traced, so the
+// tracer is off for a bar with them.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4MaterialPropertyVector.hh"
+
+class EveAct;
+class SurTab;
+class G4Track;
+
+class BoxTra
+{
+  public:
+	BoxTra(EveAct* EA);
+	~BoxTra();
+
+	// Bar, material and surface table of this run
+	void BeginOfRun();
+	void EndOfRun();
+
+	// False without a surface table, and photons are then tracked as usual
+	G4bool IsReady() const { return m_ST != 0; }
+
+	// Photon made in the bar. A full batch is traced right away.
+	void Add(const G4Track* track);
+
+	// Traces what is left. StaAct calls it when the stack runs empty, before
+	// the end of the event.
+	void Flush();
+	void Clear();
+
+  private:
+	void Trace();
+
+  private:
+	EveAct* m_EA;
+	const SurTab* m_ST;
+
+	// Bar: center and half lengths, and bulk properties
+	G4ThreeVector m_Center;
+	G4double m_Half[3];
+	const G4MaterialPropertyVector* m_AbsLength;
+	const G4MaterialPropertyVector* m_GroupVel;
+	const G4MaterialPropertyVector* m_RIndex;
+
+	// Batch, as structure of arrays. Absorption is the path left before it.
+	static const std::size_t s_BatchSize = 2048;
+	static const G4int s_MaxRounds = 100000;
+	std::size_t m_N;
+	std::vector<G4double> m_Pos[3], m_Dir[3];
+	std::vector<G4double> m_Time, m_Path, m_AbsLeft, m_InvVel, m_Weight;
+
+	// Per round: distance and axis of the next face, random numbers
+	std::vector<G4double> m_Step;
+	std::vector<G4int> m_Face;
+	std::vector<G4double> m_Rand;
+
+	// This run: photons, side face hits, and time in the tracer
+	G4long m_NPhotons;
+	G4long m_NHits;
+	G4double m_Wall;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef COLFMT_h
+#define COLFMT_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   ColFmt.hh
+//
+//   This file describes the columnar output format of mCP ('--output col').
+// It is shared by the writer (ColWri) and the reader in tools/, so it does not
+// depend on Geant4.
+//
+//   File   : magic[8] | uint32 headerSize | header | block | block | ...
+//   Header : uint32 nColumns | { uint8 type, uint8 nameLength, name } ...
+//            uint32 nMeta    | { uint16 keyLength, key, uint16 valueLength,
+//            value } ... | zero padding, so that the first block starts at a
+//            multiple of 8
+//   Block  : uint32 blockMagic | uint32 nRows | column | column | ...
+//   Column : int64 reference | uint8 width | 7 zero bytes | nRows values of
+//            width bytes | zero padding to a multiple of 8
+//
+//   'I' columns are stored as unsigned offsets from the reference, in as few
+// bytes as the block needs (0, 1, 2, 4 or 8; 0 means every value equals the
+// reference). 'D' columns are raw doubles with width 8. Every value array
+// starts at a multiple of 8 from the file start, so a reader can use the
+// mapped file in place. Numbers are in the byte order of the writing host.
+//
+//   Blocks are written as they fill up, so a file of a crashed job is
+// readable up to its last complete block.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ColFmt
+{
+	const char Magic[8] = {'m', 'C', 'P', 'c', 'o', 'l', '1', '\0'};
+	const std::uint32_t BlockMagic = 0x4B4C4243; // "CBLK"
+	const std::uint32_t BlockRows = 65536;
+
+	inline std::size_t Pad8(std::size_t n) { return (n + 7) & ~static_cast<std::size_t>(7); }
+}
+
+#endif
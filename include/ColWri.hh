@@ -0,0 +1,105 @@
+#ifndef COLWRI_h
+#define COLWRI_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   ColWri.hh
+//
+//   This file is a header for ColWri class. It writes event rows in the
+// columnar format of ColFmt.hh: rows are buffered column by column in a batch,
+// and every ColFmt::BlockRows rows the batch is packed and written as a block.
+// With AsyWri running, full batches go to its writer thread instead, and
+// filling goes on in a fresh batch.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+#include "globals.hh"
+#include "ColFmt.hh"
+
+// Rows of one block, [col][row]. Only the one of the column type is used.
+struct ColBat
+{
+	std::uint32_t nRows = 0;
+	std::vector<std::vector<std::int64_t>> iBuf;
+	std::vector<std::vector<G4double>> dBuf;
+
+	void Shape(const std::vector<char>& types);
+};
+
+class ColWri
+{
+  public:
+	ColWri();
+	~ColWri();
+
+	// Columns are name and type ('I' or 'D'), metadata is key and value.
+	G4bool Open(const G4String& fileName,
+	            const std::vector<std::pair<G4String, char>>& columns,
+	            const std::vector<std::pair<G4String, G4String>>& meta);
+	void Close();
+	G4bool IsOpen() const { return m_File != 0; }
+
+	// Values of the current row. A column not filled keeps its last value.
+	inline void FillI(G4int col, G4int value);
+	inline void FillD(G4int col, G4double value);
+	inline void AddRow();
+
+	// Packs and writes a batch. On the writer thread in asynchronous mode.
+	void WriteBlock(const ColBat& batch);
+
+	// Asynchronous mode: batches handed over and not written yet
+	void BatchDone();
+
+  private:
+	void Submit();
+	void Write(const void* data, std::size_t size);
+
+  private:
+	std::FILE* m_File;
+	std::vector<char> m_FileBuf;
+
+	std::vector<char> m_Types;
+	std::vector<std::int64_t> m_IRow;
+	std::vector<G4double> m_DRow;
+
+	// Batch being filled
+	ColBat* m_Bat;
+	G4bool m_Async;
+	std::atomic<G4int> m_Pending;
+
+	// Packed values of a column
+	std::vector<unsigned char> m_Packed;
+};
+
+//////////////////////////////////////////////////
+//   Inline functions
+//////////////////////////////////////////////////
+inline void ColWri::FillI(G4int col, G4int value)
+{
+	m_IRow[col] = value;
+}
+
+inline void ColWri::FillD(G4int col, G4double value)
+{
+	m_DRow[col] = value;
+}
+
+inline void ColWri::AddRow()
+{
+	const std::uint32_t row = m_Bat -> nRows;
+	for ( std::size_t col = 0; col < m_Types.size(); col++ )
+	{
+		if ( m_Types[col] == 'I' ) m_Bat -> iBuf[col][row] = m_IRow[col];
+		else                       m_Bat -> dBuf[col][row] = m_DRow[col];
+	}
+
+	if ( ++m_Bat -> nRows == ColFmt::BlockRows ) Submit();
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef COSGEN_h
+#define COSGEN_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   CosGen.hh
+//
+//   This file is a header for CosGen class. It is the cosmic muon generator
+// of '--cosmic': muons come down (-y) through a horizontal plane above the
+// bar, with energy and zenith angle from a built-in parametrization or from
+// a user table, and mu+/mu- from the charge ratio. 'gaisser' is the textbook
+// formula, only right above 100 GeV / cos(zenith), so it makes no muon below
+// that, and the plane rate is of those above. 'reyna' is Gaisser-type,
+// fitted to data down to 1 GeV: Reyna, hep-ph/0604145.
+//
+//   The energy x cos(zenith) distribution is binned into cells once, and the
+// cells go into a Walker alias table, so that an event costs a fixed number
+// of random numbers whatever the binning. Inside a cell, the energy is log
+// uniform and cos(zenith) is uniform. Cells are weighted by cos(zenith) too,
+// as muons are counted through a horizontal plane. Trajectories which miss
+// SciLV are thrown away and drawn again before Geant4 sees them. The number
+// of draws of each event is written, so the live time of a run is
+//   sum(muTries) / (plane rate),
+// with the plane rate printed by /mCP/cosmic/print.
+//
+//   A table has lines of 'energy/GeV cos(zenith) intensity' on a full
+// rectangular grid. With the intensity in /cm2/s/sr/GeV, the plane rate is
+// in Hz.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+class CosMes;
+class G4ParticleGun;
+class G4ParticleDefinition;
+class G4VPhysicalVolume;
+class G4Box;
+
+class CosGen
+{
+  public:
+	CosGen();
+	~CosGen();
+
+	// Process-wide spectrum, set in main(): "gaisser", "reyna" or a table file
+	static void Configure(const G4String& spectrum);
+	static G4bool IsEnabled();
+	static const G4String& GetSpectrum();
+	static void AddColumns();
+
+	// Sets particle, energy, position and direction of the gun
+	void Shoot(G4ParticleGun* PG);
+
+	// Last muon, for the event columns
+	G4double GetLastEnergy() const { return m_LastE; }
+	G4double GetLastCosZ() const { return m_LastCosZ; }
+	G4int GetLastTries() const { return m_LastTries; }
+
+	// Settings. Energies and the zenith cut do not apply to tables. Plane
+	// settings of 0 are automatic: just above the bar, and as big as the
+	// steepest muon needs.
+	void SetEnergyMin(G4double eMin)    { m_EMin = eMin; m_Dirty = true; }
+	void SetEnergyMax(G4double eMax)    { m_EMax = eMax; m_Dirty = true; }
+	void SetCosZMin(G4double cosZMin)   { m_CosZMin = cosZMin; m_Dirty = true; }
+	void SetChargeRatio(G4double ratio) { m_Ratio = ratio; }
+	void SetPlaneHalfX(G4double halfX)  { m_PlaneX = halfX; }
+	void SetPlaneHalfZ(G4double halfZ)  { m_PlaneZ = halfZ; }
+	void SetPlaneY(G4double y)          { m_PlaneY = y; }
+	void Print();
+
+  private:
+	// Grid nodes, cells and alias table for the current settings
+	void Prepare();
+	void ReadTable();
+	static G4double Gaisser(G4double energy, G4double cosZ);
+	static G4double Reyna(G4double energy, G4double cosZ);
+
+	// Does the line from pos along dir cross the bar?
+	G4bool HitsBar(const G4ThreeVector& pos, const G4ThreeVector& dir) const;
+	void FindVolumes();
+	void GetPlane(G4double& x, G4double& z, G4double& halfX, G4double& halfZ, G4double& y) const;
+
+  private:
+	// Settings
+	G4double m_EMin, m_EMax, m_CosZMin, m_Ratio;
+	G4double m_PlaneX, m_PlaneZ, m_PlaneY;
+	G4bool m_Dirty;
+
+	// Nodes, intensity on nodes (energy major), and alias table of cells
+	std::vector<G4double> m_E, m_CosZ, m_I;
+	std::vector<G4double> m_Prob;
+	std::vector<G4int> m_Alias;
+	G4double m_Integral; // /cm2/s through a horizontal plane
+
+	// Volumes
+	G4VPhysicalVolume* m_LabPV;
+	G4VPhysicalVolume* m_SciPV;
+
+	G4ParticleDefinition* m_MuP;
+	G4ParticleDefinition* m_MuM;
+
+	G4double m_LastE, m_LastCosZ;
+	G4int m_LastTries;
+
+	CosMes* m_CM;
+
+	static G4String s_Spectrum;
+
+	// Lowest energy x cos(zenith) of 'gaisser'
+	static const G4double s_GaisserMin;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef COSMES_h
+#define COSMES_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   CosMes.hh
+//
+//   This file is a header for CosMes class. It provides macro commands for
+// CosGen class.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class CosGen;
+class G4UIdirectory;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class CosMes: public G4UImessenger
+{
+  public:
+	CosMes(CosGen* CG);
+	virtual ~CosMes();
+
+	virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+
+  private:
+	CosGen* m_CG;
+
+	G4UIdirectory* m_Dir;
+	G4UIdirectory* m_CosDir;
+	G4UIcmdWithADoubleAndUnit* m_EMinCmd;
+	G4UIcmdWithADoubleAndUnit* m_EMaxCmd;
+	G4UIcmdWithADouble* m_CosZMinCmd;
+	G4UIcmdWithADouble* m_RatioCmd;
+	G4UIcmdWithADoubleAndUnit* m_PlaneXCmd;
+	G4UIcmdWithADoubleAndUnit* m_PlaneZCmd;
+	G4UIcmdWithADoubleAndUnit* m_PlaneYCmd;
+	G4UIcmdWithoutParameter* m_PrintCmd;
+};
+
+#endif
@@ -15,10 +15,14 @@
 #include "G4Element.hh"
 #include "G4Material.hh"
 #include "G4Box.hh"
+#include "G4ThreeVector.hh"
 #include "G4OpticalSurface.hh"
 #include "G4LogicalBorderSurface.hh"
 
 class G4VPhysicalVolume;
+class G4Region;
+class DetMes;
+class MatDat;
 
 class DetCon: public G4VUserDetectorConstruction
 {
@@ -26,6 +30,18 @@ class DetCon: public G4VUserDetectorConstruction
 	DetCon();
 	virtual ~DetCon();
 	virtual G4VPhysicalVolume* Construct();
+	virtual void ConstructSDandField();
+
+	// Full lengths of the bar and the lab. Once the geometry is built, the
+	// solids are resized in place and navigation is rebuilt at the next run.
+	G4ThreeVector GetSciSize() const;
+	G4ThreeVector GetLabSize() const;
+	void SetSizes(const G4ThreeVector& sci, const G4ThreeVector& lab);
+
+	// Finish of the bar surface by its name, e.g. "RoughTeflon_LUT"
+	const G4String& GetSurfaceFinish() const;
+	void SetSurfaceFinish(const G4String& finish);
+	void Print() const;
 
   private:
 	void DefineDimensions();
@@ -40,17 +56,18 @@ class DetCon: public G4VUserDetectorConstruction
 	G4Element* m_ElO;
 	G4Element* m_ElAr;
 
-	// Materials
+	// Materials, from data file
+	MatDat* m_MD;
 	G4Material* m_VacMat;
 	G4Material* m_AirMat;
 	G4Material* m_SciMat;
-	G4MaterialPropertiesTable* m_SciMPT;
-	G4MaterialPropertiesTable* m_AirMPT;
-	G4MaterialPropertiesTable* m_AirST;
+	G4Material* m_SenMat;
 
 	// Dimensions and detector setup
 	G4double m_LabX, m_LabY, m_LabZ;
 	G4double m_SciX, m_SciY, m_SciZ;
+	G4double m_SenZ;
+	G4String m_SciFinish;
 
 	// Geometry objects: World
 	G4Box* m_WorldSolid;
@@ -66,6 +83,12 @@ class DetCon: public G4VUserDetectorConstruction
 	G4Box* m_SciSolid;
 	G4LogicalVolume* m_SciLV;
 	G4VPhysicalVolume* m_SciPV;
+	G4Region* m_SciRegion;
+
+	// Geometry objects: Photosensors on +z (copy 0) and -z (copy 1) ends
+	G4Box* m_SenSolid;
+	G4LogicalVolume* m_SenLV;
+	G4VPhysicalVolume* m_SenPV[2];
 
 	// Surface objects: Scint
 	G4OpticalSurface* m_SciOpS;
@@ -73,6 +96,9 @@ class DetCon: public G4VUserDetectorConstruction
 
 	// Surface objects: Air
 	G4OpticalSurface* m_AirOpS;
+
+	// Macro commands
+	DetMes* m_DM;
 };
 
 #endif
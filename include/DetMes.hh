@@ -0,0 +1,46 @@
+#ifndef DETMES_h
+#define DETMES_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   DetMes.hh
+//
+//   This file is a header for DetMes class. It provides macro commands for
+// DetCon class.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class DetCon;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class DetMes: public G4UImessenger
+{
+  public:
+	DetMes(DetCon* DC);
+	virtual ~DetMes();
+
+	virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+	virtual G4String GetCurrentValue(G4UIcommand* command);
+
+  private:
+	DetCon* m_DC;
+
+	G4UIdirectory* m_Dir;
+	G4UIdirectory* m_DetDir;
+	G4UIcmdWithADoubleAndUnit* m_SciXCmd;
+	G4UIcmdWithADoubleAndUnit* m_SciYCmd;
+	G4UIcmdWithADoubleAndUnit* m_SciZCmd;
+	G4UIcmdWithADoubleAndUnit* m_LabXCmd;
+	G4UIcmdWithADoubleAndUnit* m_LabYCmd;
+	G4UIcmdWithADoubleAndUnit* m_LabZCmd;
+	G4UIcmdWithAString* m_FinishCmd;
+	G4UIcmdWithoutParameter* m_PrintCmd;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef DIGMES_h
+#define DIGMES_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   DigMes.hh
+//
+//   This file is a header for DigMes class. It provides macro commands for
+// WavDig class.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class WavDig;
+class G4UIdirectory;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class DigMes: public G4UImessenger
+{
+  public:
+	DigMes(WavDig* WD);
+	virtual ~DigMes();
+
+	virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+
+  private:
+	WavDig* m_WD;
+
+	G4UIdirectory* m_Dir;
+	G4UIdirectory* m_DigDir;
+	G4UIcmdWithADoubleAndUnit* m_SamplingCmd;
+	G4UIcmdWithADoubleAndUnit* m_StartCmd;
+	G4UIcmdWithADoubleAndUnit* m_WindowCmd;
+	G4UIcmdWithADoubleAndUnit* m_RiseCmd;
+	G4UIcmdWithADoubleAndUnit* m_FallCmd;
+	G4UIcmdWithADouble* m_SPECmd;
+	G4UIcmdWithADouble* m_NoiseCmd;
+	G4UIcmdWithADouble* m_ThrCmd;
+	G4UIcmdWithADouble* m_CFDCmd;
+	G4UIcmdWithoutParameter* m_PrintCmd;
+};
+
+#endif
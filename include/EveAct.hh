@@ -10,10 +10,17 @@
 //                       - 18. Dec. 2023. Hoyong Jeong (hoyong5419@korea.ac.kr)
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
 #include "globals.hh"
 #include "G4UserEventAction.hh"
+#include "G4Version.hh"
 
 class G4Event;
+class HisAcc;
+class EvePro;
+class WavDig;
+class CosGen;
 
 class EveAct: public G4UserEventAction
 {
@@ -24,13 +31,137 @@ class EveAct: public G4UserEventAction
 	virtual void BeginOfEventAction(const G4Event*);
 	virtual void EndOfEventAction(const G4Event*);
 
-	void AddScint();
-	void AddCeren();
+#if G4VERSION_NUMBER >= 1130
+	// Sub-event parallel mode: counts of a finished sub-event go to its mother
+	virtual void MergeSubEvent(G4Event* masterEvent, const G4Event* subEvent);
+#endif
+
+	// Sub-event parallel mode. A worker only sees sub-events, so it hands its
+	// counts back instead of writing them. The master writes whole events.
+	void SetSubEventMode(G4bool worker);
+
+	// Called from the step loop, so they are inlined.
+	inline void AddScint(G4int n = 1);
+	inline void AddCeren(G4int n = 1);
+
+	// Photon thinning ('--thin'): a kept photon counts with its weight 1/p.
+	// Only photons that are tracked come here; raw counts take every photon.
+	enum Weighted { kWScint = 0, kWCeren, kWEndPz, kWEndMz, kNWeighted };
+	inline void AddWeighted(G4int i, G4double weight);
+
+	// Photon killed by the acceptance filter, with the bound of its chance to
+	// arrive at an end that is lost ('--acceptance cut')
+	inline void AddFiltered(G4double lost);
+
+	// Cosmic muon generator of this thread, or 0, for the muon columns
+	void SetCosGen(const CosGen* CG) { m_CG = CG; }
+
+	// Per-event profile, or 0 if not profiling
+	EvePro* GetProfile() const { return m_Pro; }
+
+	// Mean and its error of nScint and nCeren over the events of this
+	// thread, for the summary at the end of run
+	void ResetSummary();
+	void PrintSummary() const;
+	G4int GetSummary(G4double& meanScint, G4double& errScint, G4double& meanCeren, G4double& errCeren) const;
+
+	// Photon arriving at the +z (end = +1) or -z (end = -1) end of the bar.
+	// Only used with '--optics fast' or '--optics calib'. With '--digitize',
+	// its time also goes to the waveform of that end.
+	inline void AddDetected(G4int end, G4double time, G4double weight = 1.);
+
+  private:
+	void FillSensors(const G4Event* anEvent);
+	void FillWaveforms();
+	void AddSensorWeights(const G4Event* anEvent);
 
   private:
 	G4int m_NScint;
 	G4int m_NCeren;
 
+	// Detected photons and earliest arrival time, [0] for +z and [1] for -z
+	G4int m_NDet[2];
+	G4double m_TDet[2];
+	G4int m_NDetCol;  // Column ID of nDetPz, or -1 if not booked
+
+	// Photosensor hits, from the hits collection. Column ID of nSenPz.
+	G4int m_NSenCol;
+
+	// Waveform digitizer, or 0, and column ID of ampPz. Arrival times of
+	// this event at each end; the buffers keep their capacity.
+	WavDig* m_Dig;
+	G4int m_DigCol;
+	std::vector<G4double> m_Times[2];
+
+	// Weighted counts of this event and their thinning variance, sum of
+	// w(w - 1). Column ID of wScint, or -1 if not thinning.
+	G4int m_ThinCol;
+	G4double m_WSum[kNWeighted];
+	G4double m_WVar[kNWeighted];
+
+	// Photons killed by the acceptance filter and their lost bound. Column
+	// ID of accKilled, or -1 without '--acceptance'.
+	G4int m_AccCol;
+	G4int m_AccKilled;
+	G4double m_AccLost;
+
+	// Cosmic muon generator and column ID of muE
+	const CosGen* m_CG;
+	G4int m_CosCol;
+
+	// Profile and its first column ID
+	EvePro* m_Pro;
+	G4int m_ProCol;
+
+	// Summary histograms, or 0 if not in summary mode
+	HisAcc* m_HisScint;
+	HisAcc* m_HisCeren;
+
+	// Summary: number of events, sums and sums of squares
+	G4int m_NEvents;
+	G4double m_SumScint, m_SumScint2;
+	G4double m_SumCeren, m_SumCeren2;
+	G4double m_SumW[kNWeighted], m_SumW2[kNWeighted];
+	G4double m_SumAccKilled, m_SumAccLost;
+	G4double m_SumDet[2], m_SumDet2[2];
+
+	G4bool m_SubEvent;
+	G4bool m_SubEventWorker;
 };
 
+//////////////////////////////////////////////////
+//   Add optical photon
+//////////////////////////////////////////////////
+inline void EveAct::AddScint(G4int n)
+{
+	m_NScint += n;
+}
+
+inline void EveAct::AddCeren(G4int n)
+{
+	m_NCeren += n;
+}
+
+inline void EveAct::AddWeighted(G4int i, G4double weight)
+{
+	if ( m_ThinCol < 0 ) return;
+	m_WSum[i] += weight;
+	m_WVar[i] += weight * (weight - 1.);
+}
+
+inline void EveAct::AddFiltered(G4double lost)
+{
+	m_AccKilled++;
+	m_AccLost += lost;
+}
+
+inline void EveAct::AddDetected(G4int end, G4double time, G4double weight)
+{
+	G4int side = end > 0 ? 0 : 1;
+	if ( m_NDet[side] == 0 || time < m_TDet[side] ) m_TDet[side] = time;
+	m_NDet[side]++;
+	if ( m_Dig ) m_Times[side].push_back(time);
+	AddWeighted(kWEndPz + side, weight);
+}
+
 #endif
@@ -0,0 +1,35 @@
+#ifndef EVEINF_h
+#define EVEINF_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   EveInf.hh
+//
+//   This file is a header for EveInf class. It carries per-event counts
+// attached to a G4Event. In sub-event parallel mode, this is how the counts
+// of a sub-event travel back to the event it was spawned from.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "globals.hh"
+#include "G4VUserEventInformation.hh"
+
+class EveInf: public G4VUserEventInformation
+{
+  public:
+	EveInf(G4int nScint = 0, G4int nCeren = 0);
+	virtual ~EveInf();
+
+	virtual void Print() const;
+
+	void Add(G4int nScint, G4int nCeren);
+
+	G4int GetNScint() const { return m_NScint; }
+	G4int GetNCeren() const { return m_NCeren; }
+
+  private:
+	G4int m_NScint;
+	G4int m_NCeren;
+};
+
+#endif
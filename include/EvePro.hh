@@ -0,0 +1,95 @@
+#ifndef EVEPRO_h
+#define EVEPRO_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   EvePro.hh
+//
+//   This file is a header for EvePro class. It is the per-event profile of
+// '--profile': wall and CPU time, steps by particle, peak stack depth, and
+// optical photons made and killed. The event action owns one only when
+// profiling, so the step loop pays a null pointer check otherwise.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <ctime>
+
+#include "globals.hh"
+#include "G4ParticleDefinition.hh"
+
+class EvePro
+{
+  public:
+	EvePro();
+	~EvePro();
+
+	// Columns, added in main()
+	static void AddColumns();
+
+	void BeginOfEvent();
+	void EndOfEvent();
+
+	// Ntuple columns from the given column ID on
+	void Fill(G4int firstCol) const;
+
+	inline void AddStep(const G4ParticleDefinition* par);
+	inline void AddStackDepth(G4int depth);
+	inline void AddPhotonMade();
+	inline void AddPhotonKilled();
+
+  private:
+	static G4double CPUTime();
+
+  private:
+	// Particles steps are counted for
+	const G4ParticleDefinition* m_MuM;
+	const G4ParticleDefinition* m_MuP;
+	const G4ParticleDefinition* m_ElM;
+	const G4ParticleDefinition* m_ElP;
+	const G4ParticleDefinition* m_Gam;
+	const G4ParticleDefinition* m_Opt;
+
+	std::chrono::steady_clock::time_point m_WallStart;
+	G4double m_CPUStart;
+	G4double m_Wall;
+	G4double m_CPU;
+
+	G4int m_NSteps;
+	G4int m_NStepsMu;
+	G4int m_NStepsE;
+	G4int m_NStepsGam;
+	G4int m_NStepsOpt;
+	G4int m_MaxStack;
+	G4int m_NPhoMade;
+	G4int m_NPhoKilled;
+};
+
+//////////////////////////////////////////////////
+//   Inline functions
+//////////////////////////////////////////////////
+inline void EvePro::AddStep(const G4ParticleDefinition* par)
+{
+	m_NSteps++;
+	if      ( par == m_Opt                   ) m_NStepsOpt++;
+	else if ( par == m_ElM || par == m_ElP   ) m_NStepsE++;
+	else if ( par == m_Gam                   ) m_NStepsGam++;
+	else if ( par == m_MuM || par == m_MuP   ) m_NStepsMu++;
+}
+
+inline void EvePro::AddStackDepth(G4int depth)
+{
+	if ( depth > m_MaxStack ) m_MaxStack = depth;
+}
+
+inline void EvePro::AddPhotonMade()
+{
+	m_NPhoMade++;
+}
+
+inline void EvePro::AddPhotonKilled()
+{
+	m_NPhoKilled++;
+}
+
+#endif
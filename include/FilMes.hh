@@ -0,0 +1,46 @@
+#ifndef FILMES_h
+#define FILMES_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   FilMes.hh
+//
+//   This file is a header for FilMes class. It provides macro commands for
+// SteFil class.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class SteFil;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithoutParameter;
+
+class FilMes: public G4UImessenger
+{
+  public:
+	FilMes(SteFil* SF);
+	virtual ~FilMes();
+
+	virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+	virtual G4String GetCurrentValue(G4UIcommand* command);
+
+  private:
+	SteFil* m_SF;
+
+	G4UIdirectory* m_Dir;
+	G4UIdirectory* m_FilDir;
+	G4UIcmdWithAString* m_VolCmd;
+	G4UIcmdWithAString* m_ParCmd;
+	G4UIcmdWithAString* m_ScintCmd;
+	G4UIcmdWithAString* m_CerenCmd;
+	G4UIcmdWithoutParameter* m_ResetCmd;
+	G4UIcmdWithoutParameter* m_ListCmd;
+	G4UIcmdWithABool* m_KillCmd;
+	G4UIcmdWithABool* m_LegacyCmd;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef HISACC_h
+#define HISACC_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   HisAcc.hh
+//
+//   This file is a header for HisAcc class. It is a fixed-bin 1D histogram as
+// a Geant4 accumulable: every thread fills its own, and the accumulable
+// manager merges them into master's at the end of run.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#include "globals.hh"
+#include "G4VAccumulable.hh"
+
+class HisAcc: public G4VAccumulable
+{
+  public:
+	HisAcc(const G4String& name, G4int nBins, G4double min, G4double max);
+	virtual ~HisAcc();
+
+	inline void Fill(G4double x, G4double weight = 1.);
+
+	virtual void Merge(const G4VAccumulable& other);
+	virtual void Reset();
+
+	// One header line with binning and moments, then one line per bin
+	void Write(std::ostream& os) const;
+
+  private:
+	G4double m_Min;
+	G4double m_Max;
+	G4double m_InvWidth;
+
+	// [0] underflow, [1..nBins] bins, [nBins + 1] overflow
+	std::vector<G4double> m_Bins;
+
+	// Over all entries, flows included
+	G4long m_Entries;
+	G4double m_SumW, m_SumWX, m_SumWX2;
+};
+
+//////////////////////////////////////////////////
+//   Fill
+//////////////////////////////////////////////////
+inline void HisAcc::Fill(G4double x, G4double weight)
+{
+	// NaN goes to underflow
+	std::size_t bin = 0;
+	if      ( x >= m_Max ) bin = m_Bins.size() - 1;
+	else if ( x >= m_Min ) bin = std::min(1 + static_cast<std::size_t>((x - m_Min) * m_InvWidth), m_Bins.size() - 2);
+
+	m_Bins[bin] += weight;
+	m_Entries++;
+	m_SumW += weight;
+	m_SumWX += weight * x;
+	m_SumWX2 += weight * x * x;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef MATDAT_h
+#define MATDAT_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   MatDat.hh
+//
+//   This file is a header for MatDat class. It reads materials and optical
+// surfaces from a data file (materials/mCP.mat by default; the syntax is
+// explained at its top), and owns the materials it makes. The default file is
+// taken from the installation when the working directory has none.
+//
+//   With 'compact on', property tables are shrunk when loaded: a constant
+// table becomes two points without spline, and points of a linear table that
+// lie on the line between their neighbours are dropped. Values are the same
+// at every energy, and every lookup on a photon step gets cheaper.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <vector>
+
+#include "globals.hh"
+#include "G4OpticalSurface.hh"
+
+class G4Material;
+class G4MaterialPropertiesTable;
+
+class MatDat
+{
+  public:
+	MatDat();
+	~MatDat();
+
+	// Data file of this job. Set in main before the geometry is built.
+	static void SetFileName(const G4String& fileName);
+	static const G4String& GetFileName();
+
+	// Fatal on any error, with the line it is in
+	void Load(const G4String& fileName);
+
+	// Material of "world", "lab", "bar" or "sensor", and surface by its name
+	G4Material* GetMaterial(const G4String& volume) const;
+	G4OpticalSurface* GetSurface(const G4String& name) const;
+
+	// Enums of G4OpticalSurface by their names, and back
+	static G4bool FinishFromName(const G4String& name, G4OpticalSurfaceFinish& finish);
+	static G4String NameOfFinish(G4OpticalSurfaceFinish finish);
+
+  private:
+	void AddProperty(G4MaterialPropertiesTable* MPT, const G4String& owner, const G4String& key,
+	                 std::vector<G4double>& energies, std::vector<G4double>& values, G4bool spline);
+	void Error(const G4String& message) const;
+
+  private:
+	static G4String s_FileName;
+
+	G4String m_FileName;
+	G4int m_Line;
+	G4bool m_Compact;
+
+	std::map<G4String, G4String> m_Volumes;
+	std::map<G4String, G4OpticalSurface*> m_Surfaces;
+	std::vector<G4Material*> m_Materials;
+	std::vector<G4MaterialPropertiesTable*> m_MPTs;
+};
+
+#endif
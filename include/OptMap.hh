@@ -0,0 +1,152 @@
+#ifndef OPTMAP_h
+#define OPTMAP_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   OptMap.hh
+//
+//   This file is a header for OptMap class. It is the optical response map of
+// the scintillator bar: for a photon emitted at a given z with a given
+// direction, the probability to reach either end (+z or -z) and its arrival
+// time distribution. It is filled by a full simulation in calibration mode,
+// cached on disk, and sampled by OptMod in fast mode.
+//
+//   A map file is keyed by geometry, materials and surface of the bar. If any
+// of them changes, the key changes, and the old file is simply not found.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <algorithm>
+
+#include "globals.hh"
+
+class OptMap
+{
+  public:
+	OptMap();
+	~OptMap();
+
+	// How optical photons are handled in this job. kYield makes no photon at
+	// all, see PhoYie. kTrace hands them to BoxTra, with the surface table
+	// made in calibration.
+	enum Mode { kFull = 0, kFast, kCalib, kYield, kTrace };
+	static void Configure(Mode mode, const G4String& dir);
+	static Mode GetMode();
+
+	// Binning over a bar from -halfZ to +halfZ
+	void Book(G4double halfZ, const G4String& key);
+	void Reset();
+
+	// Calibration. end is +1 or -1, delay is arrival minus emission time.
+	inline void AddEmitted(G4double z, G4double cosZ);
+	inline void AddDetected(G4double z, G4double cosZ, G4int end, G4double delay);
+	void Merge(const OptMap& other);
+
+	// Sampling. Returns the end (+1 or -1) the photon reaches, or 0 if lost.
+	// u1 and u2 are uniform random numbers.
+	inline G4int Sample(G4double z, G4double cosZ, G4double u1, G4double u2, G4double& delay) const;
+
+	// Counts -> probabilities and time CDFs
+	void Finalize();
+
+	G4bool Save(const G4String& fileName) const;
+	G4bool Load(const G4String& fileName, const G4String& key);
+
+	G4bool IsBooked() const { return !m_Key.empty(); }
+	G4double GetHalfZ() const { return m_HalfZ; }
+	const G4String& GetKey() const { return m_Key; }
+
+	// Key of the current bar, and the file of the given kind that goes with
+	// it (the map, or the surface table of SurTab)
+	static G4String ComputeKey(G4double& halfZ);
+	static G4String FileName(const G4String& key, const G4String& kind = "optmap");
+
+	// Fast mode: map shared by every thread. Set up by master at the
+	// beginning of a run, read only afterwards.
+	static void LoadShared();
+	static const OptMap* GetShared();
+
+	// Calibration mode: threads merge here at the end of a run, and master
+	// adds it to the file on disk.
+	static void MergeCalibration(const OptMap& threadMap);
+	static void SaveCalibration();
+
+  private:
+	inline G4int Bin(G4double z, G4double cosZ) const;
+
+  private:
+	// Binning
+	static constexpr G4int s_NZ   = 150;
+	static constexpr G4int s_NDir =  10;
+	static constexpr G4int s_NT   = 200;
+	static const G4double s_TMax;
+
+	G4double m_HalfZ;
+	G4String m_Key;
+
+	// Counts: [bin], [end][bin], [end][bin][time]
+	std::vector<G4double> m_NEmitted;
+	std::vector<G4double> m_NDetected;
+	std::vector<G4double> m_NTime;
+
+	// After Finalize(): [end][bin] and [end][bin][time]
+	std::vector<G4float> m_Prob;
+	std::vector<G4float> m_TimeCDF;
+
+	static Mode s_Mode;
+	static G4String s_Dir;
+};
+
+//////////////////////////////////////////////////
+//   Inline functions
+//////////////////////////////////////////////////
+inline G4int OptMap::Bin(G4double z, G4double cosZ) const
+{
+	G4int iz = static_cast<G4int>((z + m_HalfZ) / (2. * m_HalfZ) * s_NZ);
+	G4int id = static_cast<G4int>((cosZ + 1.) / 2. * s_NDir);
+	iz = std::min(std::max(iz, 0), s_NZ   - 1);
+	id = std::min(std::max(id, 0), s_NDir - 1);
+
+	return iz * s_NDir + id;
+}
+
+inline void OptMap::AddEmitted(G4double z, G4double cosZ)
+{
+	m_NEmitted[Bin(z, cosZ)] += 1.;
+}
+
+inline void OptMap::AddDetected(G4double z, G4double cosZ, G4int end, G4double delay)
+{
+	G4int side = end > 0 ? 0 : 1;
+	G4int bin = side * s_NZ * s_NDir + Bin(z, cosZ);
+	G4int it = static_cast<G4int>(delay / s_TMax * s_NT);
+	it = std::min(std::max(it, 0), s_NT - 1);
+
+	m_NDetected[bin] += 1.;
+	m_NTime[bin * s_NT + it] += 1.;
+}
+
+inline G4int OptMap::Sample(G4double z, G4double cosZ, G4double u1, G4double u2, G4double& delay) const
+{
+	const G4int nBins = s_NZ * s_NDir;
+	G4int bin = Bin(z, cosZ);
+
+	G4int side;
+	G4float pPlus = m_Prob[bin];
+	if      ( u1 < pPlus                        ) side = 0;
+	else if ( u1 < pPlus + m_Prob[nBins + bin]  ) side = 1;
+	else return 0;
+
+	// Inverse CDF with linear interpolation inside the time bin
+	const G4float* cdf = &m_TimeCDF[(side * nBins + bin) * s_NT];
+	G4int it = std::upper_bound(cdf, cdf + s_NT, static_cast<G4float>(u2)) - cdf;
+	it = std::min(it, s_NT - 1);
+	G4float lo = it > 0 ? cdf[it - 1] : 0.f;
+	G4float frac = cdf[it] > lo ? (u2 - lo) / (cdf[it] - lo) : 0.5;
+	delay = (it + frac) * s_TMax / s_NT;
+
+	return side == 0 ? +1 : -1;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef OPTMOD_h
+#define OPTMOD_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   OptMod.hh
+//
+//   This file is a header for OptMod class. It is the fast simulation model of
+// optical photons in the scintillator bar. Instead of tracking a photon
+// through thousands of reflections, it looks up OptMap, decides which end (if
+// any) the photon reaches and when, and kills it.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4VFastSimulationModel.hh"
+
+class G4Region;
+
+class OptMod: public G4VFastSimulationModel
+{
+  public:
+	OptMod(const G4String& name, G4Region* region);
+	virtual ~OptMod();
+
+	virtual G4bool IsApplicable(const G4ParticleDefinition& par);
+	virtual G4bool ModelTrigger(const G4FastTrack& fastTrack);
+	virtual void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef OUTMAN_h
+#define OUTMAN_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   OutMan.hh
+//
+//   This file is a header for OutMan class. Event rows go through here to the
+// output backend chosen in main(): the ROOT ntuple of G4RootAnalysisManager,
+// or the columnar binary format of ColWri. One per thread, like the analysis
+// manager itself.
+//
+//   In summary mode there are no rows at all. Event and stepping actions fill
+// the histograms of this thread, master merges them at the end of run and
+// writes them to a small text file.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "globals.hh"
+#include "G4RootAnalysisManager.hh"
+
+#include "ColWri.hh"
+#include "HisAcc.hh"
+
+class OutMan
+{
+  public:
+	enum Backend { kRoot = 0, kCol, kSummary };
+
+	// Summary histograms
+	enum His { kHisScint = 0, kHisCeren, kHisEdepZ, kHisOriginZ, kNHis };
+
+	// Process-wide. Set in main() before any thread starts.
+	static void SetBackend(Backend backend);
+	static Backend GetBackend();
+
+	static OutMan* Instance();
+
+	// File name without extension. ROOT files are opened right away. A
+	// columnar file is opened at the first row, so threads without rows
+	// (the master in multithreaded mode) leave no file behind. Worker files
+	// get a _t<threadID> suffix.
+	void Open(const G4String& fileBase);
+	void Close();
+
+	// Summary histogram of this thread, or 0 if not in summary mode
+	HisAcc* GetHis(His his) const { return m_His[his]; }
+
+	// Values of the ntuple row. Column IDs are those of RunAct::GetColumns().
+	inline void FillI(G4int col, G4int value);
+	inline void FillD(G4int col, G4double value);
+	inline void AddRow();
+
+  private:
+	OutMan();
+	~OutMan();
+
+	void OpenColumnar();
+
+  private:
+	G4RootAnalysisManager* m_AM;
+	ColWri* m_CW;
+	G4String m_ColFile;
+
+	HisAcc* m_His[kNHis];
+	G4String m_SumFile;
+
+	static Backend s_Backend;
+	static G4ThreadLocal OutMan* s_Instance;
+};
+
+//////////////////////////////////////////////////
+//   Inline functions
+//////////////////////////////////////////////////
+inline void OutMan::FillI(G4int col, G4int value)
+{
+	if ( m_CW ) m_CW -> FillI(col, value);
+	else        m_AM -> FillNtupleIColumn(col, value);
+}
+
+inline void OutMan::FillD(G4int col, G4double value)
+{
+	if ( m_CW ) m_CW -> FillD(col, value);
+	else        m_AM -> FillNtupleDColumn(col, value);
+}
+
+inline void OutMan::AddRow()
+{
+	if ( !m_CW ) m_AM -> AddNtupleRow();
+	else
+	{
+		if ( !m_CW -> IsOpen() ) OpenColumnar();
+		m_CW -> AddRow();
+	}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef PHOYIE_h
+#define PHOYIE_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   PhoYie.hh
+//
+//   This file is a header for PhoYie class. With '--optics yield', no optical
+// photon is generated at all. Instead, this class draws the number of
+// scintillation and Cerenkov photons a step in the bar would have made, the
+// same way G4Scintillation and G4Cerenkov do.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "globals.hh"
+#include "G4Step.hh"
+
+class G4VPhysicalVolume;
+class G4EmSaturation;
+
+class PhoYie
+{
+  public:
+	PhoYie();
+	~PhoYie();
+
+	// Material constants and tables of the bar. Once per run.
+	void Resolve();
+
+	// Number of photons of a step. Zero outside the bar.
+	inline void Sample(const G4Step* step, G4int& nScint, G4int& nCeren) const;
+
+  private:
+	G4int SampleScint(const G4Step* step) const;
+	G4int SampleCeren(const G4Step* step) const;
+
+	// Mean number of Cerenkov photons per unit length of a unit charge
+	G4double CerenPerLength(G4double beta) const;
+
+  private:
+	const G4VPhysicalVolume* m_SciPV;
+
+	// SCINTILLATIONYIELD and RESOLUTIONSCALE
+	G4double m_Yield;
+	G4double m_ResScale;
+
+	// Birks quenching, if the material has a Birks constant
+	G4EmSaturation* m_Sat;
+
+	// RINDEX table
+	std::vector<G4double> m_PhoE;
+	std::vector<G4double> m_RIndex;
+};
+
+//////////////////////////////////////////////////
+//   Inline functions
+//////////////////////////////////////////////////
+inline void PhoYie::Sample(const G4Step* step, G4int& nScint, G4int& nCeren) const
+{
+	nScint = 0;
+	nCeren = 0;
+	if ( step -> GetPreStepPoint() -> GetPhysicalVolume() != m_SciPV ) return;
+
+	if ( m_Yield > 0. && step -> GetTotalEnergyDeposit() > 0. ) nScint = SampleScint(step);
+	if ( !m_RIndex.empty() && step -> GetTrack() -> GetDefinition() -> GetPDGCharge() != 0. ) nCeren = SampleCeren(step);
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef PHYCAC_h
+#define PHYCAC_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   PhyCac.hh
+//
+//   This file is a header for PhyCac class. It builds the physics tables right
+// after initialization, and with '--physics-cache DIR' keeps them on disk
+// with Geant4's store/retrieve facility, so that the next job with the same
+// physics starts from the stored tables instead of building them again.
+//
+//   An entry is a directory named after the hash of its key: Geant4 version,
+// data set versions, EM parameters, physics constructors, optics mode,
+// production cuts and materials. The full key is written in the entry and
+// compared before it is used. Entries that do not match, or that Geant4
+// fails to read, are built and stored again.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "globals.hh"
+
+class G4RunManager;
+class G4VModularPhysicsList;
+
+class PhyCac
+{
+  public:
+	static void Configure(const G4String& dir);
+	static G4bool IsEnabled();
+
+	// After RM -> Initialize(). Builds or retrieves the tables, stores them
+	// if needed, and returns "built", "retrieved" or "stored".
+	static G4String Build(G4RunManager* RM, G4VModularPhysicsList* PL, const G4String& optics);
+
+  private:
+	static G4String ComputeKey(G4VModularPhysicsList* PL, const G4String& optics);
+	static G4String EntryName(const G4String& key);
+	static G4bool Check(const G4String& entry, const G4String& key);
+	static G4bool Store(G4VModularPhysicsList* PL, const G4String& entry, const G4String& key);
+
+  private:
+	static G4String s_Dir;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef PHYLIS_h
+#define PHYLIS_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   PhyLis.hh
+//
+//   This file is a header for PhyLis class. It is the light physics list of
+// '--physics em4' and '--physics em0': electromagnetic physics and decay
+// only, for muons crossing the bar. Optical physics is added in main as for
+// the full list. There is no hadronic physics at all, so stopped mu- decay
+// instead of being captured, and no hadronic table is ever built.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4VModularPhysicsList.hh"
+#include "globals.hh"
+
+class PhyLis: public G4VModularPhysicsList
+{
+  public:
+	// EM option4 if accurate, the standard (option0) EM physics otherwise
+	PhyLis(G4bool accurate);
+	virtual ~PhyLis();
+
+	virtual void SetCuts();
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef PRIFIL_h
+#define PRIFIL_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   PriFil.hh
+//
+//   This file is a header for PriFil class. It reads primaries of '--primaries'
+// from a file of PriFmt.hh format, e.g. made by tools/mcppri from another
+// generator.
+//
+//   The file is mapped once for the process, read-only, and every thread reads
+// it in place. Event N of a run takes the primaries of entry N (plus the
+// event ID offset of a sharded job), after the entries of earlier runs, so
+// each /run/beamOn goes on where the last one stopped. Threads read disjoint
+// entries without any lock, and the result does not depend on the number of
+// threads. Pages
+// ahead of each thread are asked for in advance, so the disk is read while
+// events are simulated and a file of any size costs only the pages in use.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+#include "globals.hh"
+#include "PriFmt.hh"
+
+class G4Event;
+class G4ParticleDefinition;
+
+class PriFil
+{
+  public:
+	PriFil();
+	~PriFil();
+
+	// Process-wide file, opened in main(). False and a message if it is not
+	// a primary file.
+	static G4bool Open(const G4String& fileName, G4String& error);
+	static void Close();
+	static G4bool IsEnabled();
+	static std::uint64_t GetNEvents();
+
+	// Primaries of the given entry go to the event.
+	void Generate(G4Event* anEvent, std::uint64_t entry);
+
+  private:
+	void Prefetch(const char* address);
+	G4ParticleDefinition* FindParticle(G4int pdg);
+
+  private:
+	// Last particle found, as inputs are mostly of one kind
+	G4int m_LastPDG;
+	G4ParticleDefinition* m_LastPar;
+
+	// End of the pages asked for by this thread
+	const char* m_Fetched;
+
+	static const char* s_Map;
+	static std::size_t s_Size;
+	static std::uint64_t s_NEvents;
+	static const std::uint64_t* s_Index;
+	static const PriFmt::Record* s_Records;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef PRIFMT_h
+#define PRIFMT_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   PriFmt.hh
+//
+//   This file describes the primary input format of mCP ('--primaries'). It
+// is shared by the reader (PriFil) and the converter in tools/, so it does
+// not depend on Geant4.
+//
+//   File   : magic[8] | uint64 nEvents | uint64 nPrimaries | uint64 indexPos
+//            | record | record | ... | index
+//   Record : int32 PDG code | uint32 zero | double x, y, z (mm), t (ns)
+//            | double px, py, pz (MeV)
+//   Index  : nEvents + 1 uint64, the first record of every event and then
+//            nPrimaries
+//
+//   Records are 64 bytes and start at a multiple of 8 from the file start, so
+// a reader can use the mapped file in place. The index is at the end, so a
+// writer can stream records out and only keep the index. Numbers are in the
+// byte order of the writing host.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+namespace PriFmt
+{
+	const char Magic[8] = {'m', 'C', 'P', 'p', 'r', 'i', '1', '\0'};
+
+	struct Header
+	{
+		char magic[8];
+		std::uint64_t nEvents;
+		std::uint64_t nPrimaries;
+		std::uint64_t indexPos;
+	};
+
+	struct Record
+	{
+		std::int32_t pdg;
+		std::uint32_t zero;
+		double x, y, z, t;
+		double px, py, pz;
+	};
+
+	static_assert(sizeof(Header) == 32, "PriFmt::Header must be 32 bytes");
+	static_assert(sizeof(Record) == 64, "PriFmt::Record must be 64 bytes");
+}
+
+#endif
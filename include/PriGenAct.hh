@@ -5,7 +5,8 @@
 //   PriGenAct.hh
 //
 //   This file is a header for PriGenAct class. You can set primary beam
-// options in this class.
+// options in this class. With '--cosmic', CosGen sets the gun every event.
+// With '--primaries', PriFil reads the primaries of every event instead.
 //
 //                       - 18. Dec. 2023. Hoyong Jeong (hoyong5419@korea.ac.kr)
 ////////////////////////////////////////////////////////////////////////////////
@@ -19,6 +20,8 @@
 #include "G4Event.hh"
 
 class G4ParticleGun;
+class CosGen;
+class PriFil;
 
 class PriGenAct: public G4VUserPrimaryGeneratorAction
 {
@@ -28,6 +31,9 @@ class PriGenAct: public G4VUserPrimaryGeneratorAction
 
 	virtual void GeneratePrimaries(G4Event* anEvent);
 
+	// Cosmic muon generator, or 0
+	const CosGen* GetCosGen() const { return m_CG; }
+
   private:
 	G4ParticleGun*   m_PG;
 	G4ParticleTable* m_PT;
@@ -39,6 +45,9 @@ class PriGenAct: public G4VUserPrimaryGeneratorAction
 	G4ParticleDefinition* m_Par;
 	G4ThreeVector m_MomDir;
 	G4double m_KinEgy;
+
+	CosGen* m_CG;
+	PriFil* m_PF;
 };
 
 #endif
@@ -10,18 +10,72 @@
 //                       - 18. Dec. 2023. Hoyong Jeong (hoyong5419@korea.ac.kr)
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+#include <utility>
+
 #include "G4UserRunAction.hh"
+#include "G4Timer.hh"
+#include "globals.hh"
 
 class G4Run;
+class SteAct;
+class EveAct;
 
 class RunAct: public G4UserRunAction
 {
   public:
-	RunAct();
+	RunAct(SteAct* SA = 0, EveAct* EA = 0);
 	virtual ~RunAct();
 
 	virtual void BeginOfRunAction(const G4Run*); 
 	virtual void   EndOfRunAction(const G4Run*);
+
+	// Wall time of the last event loop of this thread
+	G4double GetRealTime() const;
+
+	// Ntuple columns: name and type ('I' or 'D'), in column ID order.
+	// eventID, nScint and nCeren always come first. Optional columns are
+	// added in main() before any action is built.
+	static const std::vector<std::pair<G4String, char>>& GetColumns();
+	static G4int AddColumn(const G4String& name, char type);
+	static G4int GetColumnID(const G4String& name);
+
+	// Run metadata (random engine, seed, ...). Written as key/value rows of
+	// the mCPmeta ntuple. Same key overwrites.
+	static void AddMeta(const G4String& key, const G4String& value);
+	static const std::vector<std::pair<G4String, G4String>>& GetMeta();
+	static void FillMeta();
+
+	// Sharded job: output is <fileBase>_r<runID>_s<shard>.root, and event IDs
+	// start after those of the shards before, as ShaMes sets them with the
+	// events of the whole job in the run.
+	static void SetShard(const G4String& fileBase, G4int shard);
+	static void SetShardRun(G4int offset, G4int runEvents);
+	static G4int GetEventIDOffset();
+
+	// Events of the job in the runs before this one, for '--primaries'
+	static G4long GetEarlierEvents();
+
+  private:
+	// Stepping and event actions of this thread. Master has none.
+	SteAct* m_SA;
+	EveAct* m_EA;
+
+	G4Timer m_Timer;
+
+	// Ntuple columns and run metadata. Set up in main() before any thread
+	// starts.
+	static std::vector<std::pair<G4String, char>> s_Columns;
+	static std::vector<std::pair<G4String, G4String>> s_Meta;
+
+	// Sharded job. Only used in sequential mode, so process-wide is fine.
+	static G4String s_FileBase;
+	static G4int s_Shard;
+	static G4int s_EventIDOffset;
+
+	// Events of the job in this run and in the runs before. Master sets them.
+	static G4int s_RunEvents;
+	static G4long s_EarlierEvents;
 };
 
 #endif
@@ -0,0 +1,68 @@
+#ifndef SENHIT_h
+#define SENHIT_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   SenHit.hh
+//
+//   This file is a header for SenHit class. It is an optical photon arriving
+// at a photosensor on one of the bar ends. Hits come from a per-thread
+// G4Allocator pool, so after the first events no hit allocates memory. The
+// hits collection of each event still allocates its array (see SenSD).
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "globals.hh"
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+
+class SenHit: public G4VHit
+{
+  public:
+	SenHit(G4int end, G4double time, const G4ThreeVector& pos, G4float waveLength, G4int creator, G4float weight = 1.f):
+		m_Time(time), m_Pos(pos), m_WaveLength(waveLength), m_Weight(weight), m_End(end), m_Creator(creator) {}
+	virtual ~SenHit() {}
+
+	inline void* operator new(std::size_t);
+	inline void operator delete(void* hit);
+
+	// +1 for the +z end, -1 for the -z end
+	G4int GetEnd() const { return m_End; }
+	G4double GetTime() const { return m_Time; }
+	const G4ThreeVector& GetPos() const { return m_Pos; }
+	G4float GetWaveLength() const { return m_WaveLength; }
+
+	// Weight of the photon, 1/p with '--thin'
+	G4float GetWeight() const { return m_Weight; }
+
+	// Sub-type of the creator process, e.g. fScintillation, or -1
+	G4int GetCreator() const { return m_Creator; }
+
+  private:
+	// Largest first: 56 bytes with the vtable pointer
+	G4double m_Time;
+	G4ThreeVector m_Pos;
+	G4float m_WaveLength;
+	G4float m_Weight;
+	G4short m_End;
+	G4short m_Creator;
+};
+
+typedef G4THitsCollection<SenHit> SenHitsCollection;
+
+extern G4ThreadLocal G4Allocator<SenHit>* SenHitAllocator;
+
+inline void* SenHit::operator new(std::size_t)
+{
+	if ( !SenHitAllocator ) SenHitAllocator = new G4Allocator<SenHit>;
+	return (void*) SenHitAllocator -> MallocSingle();
+}
+
+inline void SenHit::operator delete(void* hit)
+{
+	SenHitAllocator -> FreeSingle((SenHit*) hit);
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef SENSD_h
+#define SENSD_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   SenSD.hh
+//
+//   This file is a header for SenSD class. It is the sensitive detector of the
+// photosensors on the bar ends ('--sensors'). An optical photon entering a
+// sensor makes a SenHit and is absorbed.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4VSensitiveDetector.hh"
+#include "globals.hh"
+
+#include "SenHit.hh"
+
+class G4ParticleDefinition;
+class G4Event;
+
+class SenSD: public G4VSensitiveDetector
+{
+  public:
+	SenSD(const G4String& name, const G4String& HCName);
+	virtual ~SenSD();
+
+	virtual void Initialize(G4HCofThisEvent* HCE);
+	virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory*);
+	virtual void EndOfEvent(G4HCofThisEvent*);
+
+	// Sensors are placed only if enabled. Set in main before the geometry is
+	// built.
+	static void Enable();
+	static G4bool IsEnabled();
+
+	// Hits collection of the sensors in an event, or 0
+	static const SenHitsCollection* GetHits(const G4Event* event);
+
+  private:
+	SenHitsCollection* m_HC;
+	G4int m_HCID;
+
+	// Most hits of an event so far. The next collection reserves as many,
+	// so that its vector does not grow hit by hit.
+	std::size_t m_Capacity;
+
+	const G4ParticleDefinition* m_OptPho;
+
+	static G4bool s_Enabled;
+};
+
+#endif
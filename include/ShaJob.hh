@@ -0,0 +1,33 @@
+#ifndef SHAJOB_h
+#define SHAJOB_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   ShaJob.hh
+//
+//   This file is a header for ShaJob class. It splits a job into shards by
+// forking after initialization. Children share geometry, materials and
+// physics tables of the parent copy-on-write, run their share of the events of
+// every /run/beamOn (see ShaMes) with their own seed, and write their own file.
+// The parent merges the files at the end.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "globals.hh"
+
+class ShaJob
+{
+  public:
+	// Fork nShards children. In a child, it returns the shard index.
+	// In the parent, it waits for all children, merges their ROOT files and
+	// returns -1 (or -2 if any child failed).
+	static G4int Fork(G4int nShards, G4long masterSeed);
+
+	// Seed of a shard. Deterministic for a given master seed.
+	static G4long DeriveSeed(G4long masterSeed, G4int shard);
+
+	// Merge shard files of every run into <fileBase>_r<runID>.root
+	static G4bool Merge(const G4String& fileBase, G4int nShards);
+};
+
+#endif
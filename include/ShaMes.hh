@@ -0,0 +1,40 @@
+#ifndef SHAMES_h
+#define SHAMES_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   ShaMes.hh
+//
+//   This file is a header for ShaMes class. In a shard of a sharded job, it
+// takes over /run/beamOn: a run of N events becomes this shard's share of
+// them, N / nShards and one more for the first N % nShards shards, with
+// event IDs following those of the shards before it. The shards of a job
+// then run N events together, as one process would.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIcommand;
+
+class ShaMes: public G4UImessenger
+{
+  public:
+	ShaMes(G4int shard, G4int nShards);
+	virtual ~ShaMes();
+
+	virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+
+	// Share of a run of nEvents, and the events of the shards before
+	static G4int GetShare(G4int nEvents, G4int shard, G4int nShards);
+	static G4int GetOffset(G4int nEvents, G4int shard, G4int nShards);
+
+  private:
+	G4int m_Shard;
+	G4int m_NShards;
+
+	G4UIcommand* m_BeamOnCmd;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef STAACT_h
+#define STAACT_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   StaAct.hh
+//
+//   This file is a header for StaAct class. User can add user-defined
+// stacking action in this class. Every new track passes here before it is
+// pushed on the stack, so this is the cheapest place to get rid of tracks.
+//
+//   Photon thinning ('--thin p') keeps an optical photon with probability p
+// and gives it the weight 1/p. The others are counted in nScint and nCeren as
+// in counting mode, and killed. Weighted counts of EveAct then estimate what
+// full tracking would give, for a fraction p of the tracking time.
+//
+//   Photons given the weight 0 by the acceptance filter ('--acceptance', see
+// AccFil.hh) are counted and killed the same way.
+//
+//   In '--optics trace', optical photons made in the bar are counted and
+// handed to the box tracer (BoxTra) instead of the stack. It traces what it
+// holds when the stack runs empty.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UserStackingAction.hh"
+#include "G4Version.hh"
+
+#include "EveAct.hh"
+
+class G4ParticleDefinition;
+class G4VPhysicalVolume;
+class StaMes;
+class BoxTra;
+class EvePro;
+
+class StaAct: public G4UserStackingAction
+{
+  public:
+	StaAct(EveAct* EA);
+	virtual ~StaAct();
+
+	virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+	virtual void PrepareNewEvent();
+	virtual void NewStage();
+
+	void SetCountOnly(G4bool countOnly);
+	G4bool GetCountOnly() const;
+
+	// Thinning: process-wide default and weighted columns, set in main().
+	// Every thread can change its probability afterwards.
+	static void EnableThinning(G4double keep);
+	void SetKeepProbability(G4double keep);
+	G4double GetKeepProbability() const;
+
+	// Sub-event parallel mode: ship optical photons to other workers
+	void SetShipPhotons(G4bool shipPhotons);
+
+	// Box tracer of this thread, or 0
+	void SetBoxTracer(BoxTra* BT) { m_BT = BT; }
+
+  private:
+	// Counts a photon at its creation and kills it
+	G4ClassificationOfNewTrack CountAndKill(const G4Track* track);
+
+  private:
+	EveAct* m_EA;
+	StaMes* m_SM;
+
+	// Counting mode: optical photons are tallied and killed before tracking
+	G4bool m_CountOnly;
+
+	// Probability to keep an optical photon, 1 if not thinning
+	G4double m_Keep;
+	static G4double s_Keep;
+	static G4bool s_Thinning;
+
+	// Optical photons go to the sub-event stack
+	G4bool m_ShipPhotons;
+
+	// Box tracer, or 0 if not in trace mode
+	BoxTra* m_BT;
+
+	const G4ParticleDefinition* m_OptPho;
+	const G4VPhysicalVolume* m_SciPV;
+
+	// Per-event profile of the event action, or 0 if not profiling
+	EvePro* m_Pro;
+};
+
+#endif
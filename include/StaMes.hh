@@ -0,0 +1,39 @@
+#ifndef STAMES_h
+#define STAMES_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   StaMes.hh
+//
+//   This file is a header for StaMes class. It provides macro commands for
+// StaAct class.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class StaAct;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+
+class StaMes: public G4UImessenger
+{
+  public:
+	StaMes(StaAct* SA);
+	virtual ~StaMes();
+
+	virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+	virtual G4String GetCurrentValue(G4UIcommand* command);
+
+  private:
+	StaAct* m_SA;
+
+	G4UIdirectory* m_Dir;
+	G4UIdirectory* m_StaDir;
+	G4UIcmdWithABool* m_CountOnlyCmd;
+	G4UIcmdWithADouble* m_KeepCmd;
+};
+
+#endif
@@ -14,8 +14,19 @@
 #include "G4UserSteppingAction.hh"
 
 #include "EveAct.hh"
+#include "SteFil.hh"
+#include "OptMap.hh"
+#include "PhoYie.hh"
+#include "SteCos.hh"
+#include "AccFil.hh"
+#include "SurTab.hh"
+#include "BoxTra.hh"
 
 class EveAct;
+class G4VPhysicalVolume;
+class G4ParticleDefinition;
+class HisAcc;
+class EvePro;
 
 class SteAct: public G4UserSteppingAction
 {
@@ -25,8 +36,58 @@ class SteAct: public G4UserSteppingAction
 
 	virtual void UserSteppingAction(const G4Step*);
 
+	// RunAct calls these at the beginning and the end of every run.
+	void BeginOfRun();
+	void EndOfRun();
+	G4long GetNSteps() const;
+
+	// Box tracer of '--optics trace', or 0. StaAct feeds it.
+	BoxTra* GetBoxTracer() const { return m_BT; }
+
+  private:
+	void LegacySteppingAction(const G4Step*);
+
+	// '--optics calib': fills the optical response map of this thread
+	void Calibrate(const G4Step*);
+
+	// '--output summary': energy deposit and photon origin along the bar.
+	// nPhotons < 0 means the track of this step is a counted photon.
+	void FillSummary(const G4Step*, G4int nPhotons);
+
   private:
 	EveAct* m_EA;
+	SteFil* m_SF;
+
+	G4bool m_Legacy;
+	G4long m_NSteps;
+
+	// Per-event profile of the event action, or 0 if not profiling
+	EvePro* m_Pro;
+
+	// Step cost by process and volume, or 0 if not profiling
+	SteCos* m_Cos;
+
+	const G4VPhysicalVolume* m_SciPV;
+
+	// Calibration map and surface table of this thread, or 0 if not in
+	// calibration mode. Half widths of the bar, to tell its side faces.
+	OptMap* m_Cal;
+	SurTab* m_Sur;
+	G4double m_SciHalf[2];
+	const G4ParticleDefinition* m_OptPhoton;
+
+	// Photon counts from energy deposit, or 0 if not in yield mode
+	PhoYie* m_PY;
+
+	// Acceptance filter of new photons, or 0 without '--acceptance'
+	AccFil* m_AF;
+
+	// Box tracer, or 0 if not in trace mode
+	BoxTra* m_BT;
+
+	// Summary histograms, or 0 if not in summary mode
+	HisAcc* m_HisEdepZ;
+	HisAcc* m_HisOriginZ;
 };
 
 #endif
@@ -0,0 +1,89 @@
+#ifndef STECOS_h
+#define STECOS_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   SteCos.hh
+//
+//   This file is a header for SteCos class. It is the step cost profiler of
+// '--cost': the time from one step to the next on a thread is charged to the
+// process that defined the step and the volume it started in. Counters are
+// per thread and need no lock in the step loop. At the end of run, threads
+// merge by name and master prints a table sorted by time.
+//
+//   The time of a step includes everything Geant4 does around it (stacking,
+// navigation, the step itself and user actions), so it is what a process
+// costs in practice, not only in its own DoIt.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "globals.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4VProcess.hh"
+#include "G4Track.hh"
+
+class G4VPhysicalVolume;
+
+class SteCos
+{
+  public:
+	SteCos();
+	~SteCos();
+
+	// Process-wide switch, set in main()
+	static void Enable();
+	static G4bool IsEnabled();
+
+	void Reset();
+	inline void AddStep(const G4Step* step);
+
+	// Threads at the end of run, and master after them
+	void MergeRun() const;
+	static void PrintRun();
+
+  private:
+	typedef std::pair<const G4VProcess*, const G4VPhysicalVolume*> Key;
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& key) const
+		{
+			return std::hash<const void*>()(key.first) * 31 + std::hash<const void*>()(key.second);
+		}
+	};
+	struct Cost
+	{
+		G4long nSteps = 0;
+		G4double time = 0.; // s
+	};
+
+	std::unordered_map<Key, Cost, KeyHash> m_Costs;
+	std::chrono::steady_clock::time_point m_Last;
+
+	static G4bool s_Enabled;
+};
+
+//////////////////////////////////////////////////
+//   Add step
+//////////////////////////////////////////////////
+inline void SteCos::AddStep(const G4Step* step)
+{
+	auto now = std::chrono::steady_clock::now();
+	G4double dt = std::chrono::duration<G4double>(now - m_Last).count();
+	m_Last = now;
+
+	// The first step of an event also carries the time between events.
+	const G4Track* track = step -> GetTrack();
+	if ( track -> GetParentID() == 0 && track -> GetCurrentStepNumber() == 1 ) dt = 0.;
+
+	Cost& cost = m_Costs[Key(step -> GetPostStepPoint() -> GetProcessDefinedStep(), step -> GetPreStepPoint() -> GetPhysicalVolume())];
+	cost.nSteps++;
+	cost.time += dt;
+}
+
+#endif
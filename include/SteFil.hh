@@ -0,0 +1,110 @@
+#ifndef STEFIL_h
+#define STEFIL_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   SteFil.hh
+//
+//   This file is a header for SteFil class. It decides which steps SteAct
+// cares about. Conditions are given by name (from a macro), and they are
+// resolved to pointers once at the beginning of every run, so that the step
+// loop only compares pointers.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "globals.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+
+class G4VPhysicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+class FilMes;
+
+class SteFil
+{
+  public:
+	SteFil();
+	~SteFil();
+
+	// What a step turned out to be
+	enum Result { kNoMatch = 0, kMatch, kScint, kCeren };
+
+	// Conditions by name. They take effect at the next begin of run.
+	void AddVolume(const G4String& name);
+	void AddParticle(const G4String& name);
+	void AddScintProcess(const G4String& name);
+	void AddCerenProcess(const G4String& name);
+	void Reset();
+	void List() const;
+
+	void SetKill(G4bool kill);
+	G4bool GetKill() const;
+
+	// String comparing stepping, kept only to benchmark against
+	void SetLegacy(G4bool legacy);
+	G4bool GetLegacy() const;
+
+	// Names -> pointers. Call at the beginning of every run.
+	void Resolve();
+
+	// Hot path. Pointer comparisons only.
+	inline Result Match(const G4Step* step) const;
+
+  private:
+	template <typename T>
+	static inline G4bool Contains(const std::vector<const T*>& list, const T* ptr);
+
+  private:
+	FilMes* m_FM;
+
+	// Conditions by name
+	std::vector<G4String> m_VolNames;
+	std::vector<G4String> m_ParNames;
+	std::vector<G4String> m_ScintNames;
+	std::vector<G4String> m_CerenNames;
+
+	// Resolved conditions
+	std::vector<const G4VPhysicalVolume*> m_Vols;
+	std::vector<const G4ParticleDefinition*> m_Pars;
+	std::vector<const G4VProcess*> m_ScintProcs;
+	std::vector<const G4VProcess*> m_CerenProcs;
+
+	// Kill matched tracks. If not, a track is matched only at its first step.
+	G4bool m_Kill;
+
+	G4bool m_Legacy;
+};
+
+//////////////////////////////////////////////////
+//   Inline functions
+//////////////////////////////////////////////////
+template <typename T>
+inline G4bool SteFil::Contains(const std::vector<const T*>& list, const T* ptr)
+{
+	// Lists hold one or two entries. A linear scan beats anything fancier.
+	for ( const T* entry: list ) if ( entry == ptr ) return true;
+	return false;
+}
+
+inline SteFil::Result SteFil::Match(const G4Step* step) const
+{
+	const G4Track* track = step -> GetTrack();
+
+	if ( !Contains(m_Pars, track -> GetParticleDefinition()) ) return kNoMatch;
+	if ( !m_Kill && track -> GetCurrentStepNumber() != 1 ) return kNoMatch;
+
+	const G4VPhysicalVolume* postPV = step -> GetPostStepPoint() -> GetPhysicalVolume();
+	if ( !Contains(m_Vols, postPV) ) return kNoMatch;
+
+	const G4VProcess* creProc = track -> GetCreatorProcess();
+	if ( creProc == 0 ) return kMatch;
+	if ( Contains(m_ScintProcs, creProc) ) return kScint;
+	if ( Contains(m_CerenProcs, creProc) ) return kCeren;
+
+	return kMatch;
+}
+
+#endif
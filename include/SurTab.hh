@@ -0,0 +1,134 @@
+#ifndef SURTAB_h
+#define SURTAB_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   SurTab.hh
+//
+//   This file is a header for SurTab class. It is the table of what the side
+// faces of the bar do to an optical photon coming from inside: for each angle
+// of incidence, the probability to be reflected or to leave the bar, and the
+// direction of the reflected photon. BoxTra samples it in '--optics trace'.
+//
+//   The table is not computed from the surface model. It is counted from
+// full tracking in '--optics calib', so it holds whatever the surface is
+// (the DAVIS look-up table by default), in 1 degree bins of incidence like
+// that table. The reflected direction is binned in the cosine to the normal
+// and the azimuth to the plane of incidence, folded to [0, pi] since the
+// surface has no handedness. It is kept next to the map of the bar, under
+// the same key.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4PhysicalConstants.hh"
+
+class SurTab
+{
+  public:
+	SurTab();
+	~SurTab();
+
+	enum Outcome { kAbsorbed = 0, kReflected, kTransmitted };
+
+	void Book(const G4String& key);
+	G4bool IsBooked() const { return !m_Key.empty(); }
+	const G4String& GetKey() const { return m_Key; }
+
+	// Calibration. in and out are the directions before and after the face
+	// normal to the given axis (0 for x, 1 for y).
+	void Fill(const G4ThreeVector& in, const G4ThreeVector& out, G4int axis, G4bool absorbed);
+	void Merge(const SurTab& other);
+
+	// Counts -> probabilities and direction CDFs
+	void Finalize();
+
+	// Sampling at the given cosine of incidence, with four uniform random
+	// numbers. A reflected photon gets its cosine to the inward normal and
+	// its azimuth to the plane of incidence.
+	inline G4int Sample(G4double cosIn, const G4double* u, G4double& cosOut, G4double& phi) const;
+
+	// Frame of a face normal to the axis, hit with direction dir: outward
+	// normal, and the plane of incidence (e1) and its normal (e2).
+	static inline void Frame(const G4ThreeVector& dir, G4int axis, G4ThreeVector& n, G4ThreeVector& e1, G4ThreeVector& e2);
+
+	G4bool Save(const G4String& fileName) const;
+	G4bool Load(const G4String& fileName, const G4String& key);
+
+	// '--optics trace': table shared by every thread. Set up by master at the
+	// beginning of a run, read only afterwards.
+	static void LoadShared();
+	static const SurTab* GetShared();
+
+	// '--optics calib': threads merge here at the end of a run, and master
+	// adds it to the file on disk.
+	static void MergeCalibration(const SurTab& threadTab);
+	static void SaveCalibration();
+
+  private:
+	inline G4int InBin(G4double cosIn) const;
+
+  private:
+	// Binning
+	static constexpr G4int s_NIn  = 90;
+	static constexpr G4int s_NCos = 30;
+	static constexpr G4int s_NPhi = 18;
+
+	G4String m_Key;
+
+	// Counts: [in], and [in][cos][phi] of reflected photons
+	std::vector<G4double> m_NHit;
+	std::vector<G4double> m_NRefl;
+	std::vector<G4double> m_NTrans;
+	std::vector<G4double> m_NDir;
+
+	// After Finalize(): [in] and [in][cos][phi]
+	std::vector<G4float> m_PRefl;
+	std::vector<G4float> m_PTrans;
+	std::vector<G4float> m_DirCDF;
+};
+
+//////////////////////////////////////////////////
+//   Inline functions
+//////////////////////////////////////////////////
+inline G4int SurTab::InBin(G4double cosIn) const
+{
+	G4int bin = static_cast<G4int>(std::acos(std::min(std::max(cosIn, 0.), 1.)) / CLHEP::pi * 180.);
+	return std::min(bin, s_NIn - 1);
+}
+
+inline void SurTab::Frame(const G4ThreeVector& dir, G4int axis, G4ThreeVector& n, G4ThreeVector& e1, G4ThreeVector& e2)
+{
+	n = G4ThreeVector();
+	n[axis] = dir[axis] < 0. ? -1. : 1.;
+	e1 = dir;
+	e1[axis] = 0.;
+	if ( e1.mag2() < 1.e-24 ) e1 = G4ThreeVector(0., 0., 1.);
+	e1 = e1.unit();
+	e2 = n.cross(e1);
+}
+
+inline G4int SurTab::Sample(G4double cosIn, const G4double* u, G4double& cosOut, G4double& phi) const
+{
+	G4int in = InBin(cosIn);
+	if ( u[0] >= m_PRefl[in] ) return u[0] < m_PRefl[in] + m_PTrans[in] ? kTransmitted : kAbsorbed;
+
+	// Cell of the direction, and a uniform point in it. The sign of the
+	// azimuth comes from what is left of the last number.
+	const G4int nCells = s_NCos * s_NPhi;
+	const G4float* cdf = &m_DirCDF[in * nCells];
+	G4int cell = std::upper_bound(cdf, cdf + nCells, static_cast<G4float>(u[1])) - cdf;
+	cell = std::min(cell, nCells - 1);
+	G4double v = 2. * u[3];
+	G4double sign = v < 1. ? 1. : -1.;
+	cosOut = (cell / s_NPhi + u[2]) / s_NCos;
+	phi = sign * (cell % s_NPhi + v - (v < 1. ? 0. : 1.)) * CLHEP::pi / s_NPhi;
+	return kReflected;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef WAVDIG_h
+#define WAVDIG_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   WavDig.hh
+//
+//   This file is a header for WavDig class. It is the waveform digitizer of
+// '--digitize': photon arrival times at a bar end are binned on the sampling
+// grid, convolved with the single photoelectron template, given noise, and
+// read out as amplitude, threshold crossing time and CFD time.
+//
+//   The work is per sample, not per photon: binning is one multiply-add per
+// photon, and the template is added once per non-empty sample, as a
+// contiguous loop the compiler vectorizes. Buffers belong to the digitizer
+// of each thread and are only resized when the settings change.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "globals.hh"
+
+class DigMes;
+
+class WavDig
+{
+  public:
+	WavDig();
+	~WavDig();
+
+	// Columns, added in main()
+	static void AddColumns();
+
+	// Digitizes the photons of one end. Times are -1 if not found.
+	void Digitize(const std::vector<G4double>& times, G4double& amp, G4double& tThr, G4double& tCfd);
+
+	// Settings. Amplitudes are in mV, and a single photoelectron peaks at
+	// the SPE amplitude.
+	void SetSampling(G4double dt)      { m_Dt = dt; m_Dirty = true; }
+	void SetStart(G4double t0)         { m_T0 = t0; m_Dirty = true; }
+	void SetWindow(G4double window)    { m_Window = window; m_Dirty = true; }
+	void SetRiseTime(G4double rise)    { m_Rise = rise; m_Dirty = true; }
+	void SetFallTime(G4double fall)    { m_Fall = fall; m_Dirty = true; }
+	void SetSPEAmplitude(G4double amp) { m_SPEAmp = amp; m_Dirty = true; }
+	void SetNoise(G4double noise)      { m_Noise = noise; }
+	void SetThreshold(G4double thr)    { m_Thr = thr; }
+	void SetCFDFraction(G4double frac) { m_CFD = frac; }
+	void Print() const;
+
+  private:
+	// Template and buffers for the current settings
+	void Prepare();
+
+  private:
+	// Settings
+	G4double m_Dt, m_T0, m_Window;
+	G4double m_Rise, m_Fall, m_SPEAmp;
+	G4double m_Noise, m_Thr, m_CFD;
+	G4bool m_Dirty;
+
+	// Single photoelectron template, and per-event buffers
+	std::vector<float> m_Template;
+	std::vector<float> m_Counts;
+	std::vector<float> m_Wave;
+	std::vector<G4double> m_Rand;
+
+	DigMes* m_DM;
+};
+
+#endif
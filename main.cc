@@ -7,38 +7,115 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <unistd.h>
+#include <sys/resource.h>
+#include <getopt.h>
+#include <cstdlib>
+#include <cerrno>
 
 #include "DetCon.hh"
 #include "ActIni.hh"
+#include "ShaJob.hh"
+#include "RunAct.hh"
+#include "OptMap.hh"
+#include "OutMan.hh"
+#include "AsyWri.hh"
+#include "EvePro.hh"
+#include "SteCos.hh"
+#include "BenRun.hh"
+#include "PhyCac.hh"
+#include "PhyLis.hh"
+#include "MatDat.hh"
+#include "SenSD.hh"
+#include "WavDig.hh"
+#include "CosGen.hh"
+#include "PriFil.hh"
+#include "StaAct.hh"
+#include "AccFil.hh"
 
-#include "G4MTRunManager.hh"
+#include "G4RunManagerFactory.hh"
 #include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "G4Version.hh"
 #include "G4UIterminal.hh"
 #include "G4UItcsh.hh"
 #include "G4UImanager.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
 #include "G4String.hh"
+#include "G4Timer.hh"
 #include "Randomize.hh"
+#include "CLHEP/Random/MixMaxRng.h"
+#include "CLHEP/Random/RanluxEngine.h"
+#include "CLHEP/Random/MTwistEngine.h"
 
 #include "QGSP_BERT.hh"
 #include "G4EmStandardPhysics_option4.hh"
 #include "G4OpticalPhysics.hh"
+#include "G4FastSimulationPhysics.hh"
+#include "G4OpticalParameters.hh"
 
 // Declaration of PrintHelp()
 void PrintHelp();
 
+// Random engine from its name, e.g. "mixmax", "ranlux:3", "mt"
+CLHEP::HepRandomEngine* CreateEngine(const G4String& spec);
+
+// Long options without a short one
+enum { OPT_RNG = 1000, OPT_SEED, OPT_OPTICS, OPT_MAPDIR, OPT_OUTPUT, OPT_ASYNC, OPT_PROFILE, OPT_COST, OPT_BENCH, OPT_BENCHREF, OPT_PHYCACHE, OPT_PHYSICS, OPT_MATERIALS, OPT_SENSORS, OPT_DIGITIZE, OPT_COSMIC, OPT_PRIMARIES, OPT_THIN, OPT_ACCEPT };
+
 //////////////////////////////////////////////////
 //   Main function                              //
 //////////////////////////////////////////////////
 int main(int argc, char** argv)
 {
 	// Read options
-	int flag_b = 0, flag_g = 0, flag_h = 0, flag_m = 0;
-	const char* optDic = "bghm:"; // Option dictionary
+	int flag_b = 0, flag_g = 0, flag_h = 0, flag_m = 0, flag_t = 0, flag_p = 0, flag_s = 0, flag_j = 0;
+	const char* optDic = "bghj:m:ps:t:"; // Option dictionary
+	const struct option longOptDic[] =   // Long option dictionary
+	{
+		{"rng" , required_argument, 0, OPT_RNG },
+		{"seed", required_argument, 0, OPT_SEED},
+		{"optics" , required_argument, 0, OPT_OPTICS},
+		{"map-dir", required_argument, 0, OPT_MAPDIR},
+		{"output" , required_argument, 0, OPT_OUTPUT},
+		{"async"  , required_argument, 0, OPT_ASYNC },
+		{"profile", no_argument      , 0, OPT_PROFILE},
+		{"cost"   , no_argument      , 0, OPT_COST   },
+		{"bench"    , required_argument, 0, OPT_BENCH   },
+		{"bench-ref", required_argument, 0, OPT_BENCHREF},
+		{"physics-cache", required_argument, 0, OPT_PHYCACHE},
+		{"physics"      , required_argument, 0, OPT_PHYSICS },
+		{"materials"    , required_argument, 0, OPT_MATERIALS},
+		{"sensors"      , no_argument      , 0, OPT_SENSORS  },
+		{"digitize"     , no_argument      , 0, OPT_DIGITIZE },
+		{"cosmic"       , required_argument, 0, OPT_COSMIC   },
+		{"primaries"    , required_argument, 0, OPT_PRIMARIES},
+		{"thin"         , required_argument, 0, OPT_THIN     },
+		{"acceptance"   , required_argument, 0, OPT_ACCEPT   },
+		{0, 0, 0, 0}
+	};
 	int option;
 	char* macro;
-	while ( (option = getopt(argc, argv, optDic)) != -1 ) // -1 means getopt() parses all options.
+	int nThreads = 0;
+	int subEvtSize = 0;
+	int nShards = 0;
+	G4String rngSpec = "ranlux:4";
+	int flag_seed = 0;
+	G4long seed = 0;
+	G4String optics = "full";
+	G4String physics = "full";
+	G4String mapDir = ".";
+	G4String output = "root";
+	int nBatches = 0;
+	G4String primaries = "";
+	double keep = 1.;
+	int flag_thin = 0;
+	G4String acceptance = "";
+	int flag_profile = 0;
+	int flag_digitize = 0;
+	G4String bench = "";
+	G4String benchRef = "bench/reference.txt";
+	while ( (option = getopt_long(argc, argv, optDic, longOptDic, 0)) != -1 ) // -1 means getopt() parses all options.
 	{
 		switch ( option )
 		{
@@ -51,10 +128,94 @@ int main(int argc, char** argv)
 			case 'h' :
 				flag_h = 1;
 				break;
+			case 'j' :
+				flag_j = 1;
+				nShards = atoi(optarg);
+				break;
 			case 'm' :
 				flag_m = 1;
 				macro = optarg;
 				break;
+			case 'p' :
+				flag_p = 1;
+				break;
+			case 's' :
+				flag_s = 1;
+				subEvtSize = atoi(optarg);
+				break;
+			case 't' :
+				flag_t = 1;
+				nThreads = atoi(optarg);
+				break;
+			case OPT_RNG :
+				rngSpec = optarg;
+				break;
+			case OPT_SEED :
+			{
+				// Whole argument, non-negative and in range
+				flag_seed = 1;
+				char* end = 0;
+				errno = 0;
+				seed = strtol(optarg, &end, 10);
+				if ( end == optarg || *end != '\0' || errno == ERANGE || seed < 0 )
+				{
+					std::cout << "'--seed' needs a non-negative integer." << std::endl;
+					return 1;
+				}
+				break;
+			}
+			case OPT_OPTICS :
+				optics = optarg;
+				break;
+			case OPT_MAPDIR :
+				mapDir = optarg;
+				break;
+			case OPT_OUTPUT :
+				output = optarg;
+				break;
+			case OPT_ASYNC :
+				nBatches = atoi(optarg);
+				break;
+			case OPT_PROFILE :
+				flag_profile = 1;
+				break;
+			case OPT_COST :
+				SteCos::Enable();
+				break;
+			case OPT_BENCH :
+				bench = optarg;
+				break;
+			case OPT_BENCHREF :
+				benchRef = optarg;
+				break;
+			case OPT_PHYCACHE :
+				PhyCac::Configure(optarg);
+				break;
+			case OPT_PHYSICS :
+				physics = optarg;
+				break;
+			case OPT_MATERIALS :
+				MatDat::SetFileName(optarg);
+				break;
+			case OPT_SENSORS :
+				SenSD::Enable();
+				break;
+			case OPT_DIGITIZE :
+				flag_digitize = 1;
+				break;
+			case OPT_COSMIC :
+				CosGen::Configure(optarg);
+				break;
+			case OPT_PRIMARIES :
+				primaries = optarg;
+				break;
+			case OPT_THIN :
+				flag_thin = 1;
+				keep = atof(optarg);
+				break;
+			case OPT_ACCEPT :
+				acceptance = optarg;
+				break;
 			case '?' :
 				flag_h = 1;
 				break;
@@ -68,19 +229,253 @@ int main(int argc, char** argv)
 		return 0;
 	}
 
+	// Sharded job: processes instead of threads, and nobody to talk to
+	if ( flag_j )
+	{
+		if ( nShards <= 0 || flag_t || flag_s || flag_g || !flag_m )
+		{
+			std::cout << "'-j' needs a positive number of shards and a macro, and does not go with '-t', '-s' or '-g'." << std::endl;
+			return 1;
+		}
+		flag_b = 1;
+	}
+
+	// Benchmark: one fixed workload in sequential mode, without macro or UI
+	if ( bench != "" )
+	{
+		if ( !BenRun::Has(bench) || flag_j || flag_g || flag_m || flag_t || flag_s || CosGen::IsEnabled() || primaries != "" )
+		{
+			std::cout << "'--bench' needs one of the workloads below, and does not go with '-j', '-g', '-m', '-t', '-s'," << std::endl;
+			std::cout << "'--cosmic' or '--primaries'." << std::endl;
+			BenRun::PrintWorkloads();
+			return 1;
+		}
+		flag_b = 1;
+		if ( !flag_seed ) seed = 12345;
+		flag_seed = 1;
+	}
+	G4Timer initTimer;
+	initTimer.Start();
+
+	// Output backend
+	// ROOT ntuple, or the columnar binary format of ColFmt.hh for long
+	// productions. Read the latter with tools/mcpcol. Summary writes only a
+	// few histograms, whatever the number of events.
+	if      ( output == "root"    ) OutMan::SetBackend(OutMan::kRoot);
+	else if ( output == "col"     ) OutMan::SetBackend(OutMan::kCol);
+	else if ( output == "summary" ) OutMan::SetBackend(OutMan::kSummary);
+	else
+	{
+		std::cout << "Unknown output backend '" << output << "'. Try '-h'." << std::endl;
+		return 1;
+	}
+	// Shards write a summary each, and nothing adds them up.
+	if ( flag_j && OutMan::GetBackend() == OutMan::kSummary )
+	{
+		std::cout << "'--output summary' does not go with '-j'." << std::endl;
+		return 1;
+	}
+	if ( nBatches > 0 )
+	{
+		// ROOT files belong to the analysis manager of each thread, so only
+		// columnar output can be written from elsewhere.
+		if ( OutMan::GetBackend() != OutMan::kCol )
+		{
+			std::cout << "'--async' needs '--output col'." << std::endl;
+			return 1;
+		}
+		AsyWri::Enable(nBatches);
+	}
+
+	// Optical photons in the bar
+	// 'full' tracks every photon. 'calib' tracks them too, and records where
+	// they end up in the response map of the bar. 'fast' samples that map.
+	// 'yield' makes no photon, and only counts how many there would be.
+	OptMap::Mode opticsMode;
+	if      ( optics == "full"  ) opticsMode = OptMap::kFull;
+	else if ( optics == "fast"  ) opticsMode = OptMap::kFast;
+	else if ( optics == "calib" ) opticsMode = OptMap::kCalib;
+	else if ( optics == "yield" ) opticsMode = OptMap::kYield;
+	else if ( optics == "trace" ) opticsMode = OptMap::kTrace;
+	else
+	{
+		std::cout << "Unknown optics mode '" << optics << "'. Try '-h'." << std::endl;
+		return 1;
+	}
+	G4bool mapped = opticsMode == OptMap::kFast || opticsMode == OptMap::kCalib || opticsMode == OptMap::kTrace;
+	if ( mapped && flag_s )
+	{
+		std::cout << "'--optics " << optics << "' does not go with '-s'." << std::endl;
+		return 1;
+	}
+	OptMap::Configure(opticsMode, mapDir);
+	RunAct::AddMeta("optics", optics);
+	if ( mapped )
+	{
+		// Photons arriving at +z and -z ends, and the earliest arrival time
+		RunAct::AddColumn("nDetPz", 'I');
+		RunAct::AddColumn("nDetMz", 'I');
+		RunAct::AddColumn("tDetPz", 'D');
+		RunAct::AddColumn("tDetMz", 'D');
+	}
+
+	// Physics list
+	// 'full' is QGSP_BERT with EM option4. 'em4' and 'em0' drop hadronic
+	// physics, and keep EM (option4 or standard), decay and optics.
+	if ( physics != "full" && physics != "em4" && physics != "em0" )
+	{
+		std::cout << "Unknown physics list '" << physics << "'. Try '-h'." << std::endl;
+		return 1;
+	}
+	RunAct::AddMeta("physics", physics);
+	RunAct::AddMeta("materials", MatDat::GetFileName());
+
+	// Photosensors on the bar ends
+	// Photons are tracked to them and make hits. Hits per end and the first
+	// arrival time of each event are written.
+	if ( SenSD::IsEnabled() )
+	{
+		if ( flag_s || opticsMode != OptMap::kFull )
+		{
+			std::cout << "'--sensors' needs '--optics full', and does not go with '-s'." << std::endl;
+			return 1;
+		}
+		RunAct::AddColumn("nSenPz", 'I');
+		RunAct::AddColumn("nSenMz", 'I');
+		RunAct::AddColumn("tSenPz", 'D');
+		RunAct::AddColumn("tSenMz", 'D');
+	}
+	RunAct::AddMeta("sensors", SenSD::IsEnabled() ? "on" : "off");
+
+	// Waveforms of both ends from photon arrival times: amplitude, threshold
+	// and CFD time. Settings are under /mCP/digi/.
+	if ( flag_digitize )
+	{
+		if ( !SenSD::IsEnabled() && !mapped )
+		{
+			std::cout << "'--digitize' needs photon arrival times: '--sensors', or '--optics fast', 'calib' or 'trace'." << std::endl;
+			return 1;
+		}
+		WavDig::AddColumns();
+	}
+
+	// Primary particles
+	// The fixed beam by default. Cosmic muons come with their energy,
+	// zenith angle and the number of draws it took to hit the bar. A
+	// primary file is mapped here, and event N of a run reads its entry N.
+	if ( CosGen::IsEnabled() && primaries != "" )
+	{
+		std::cout << "'--cosmic' and '--primaries' do not go together." << std::endl;
+		return 1;
+	}
+	if ( CosGen::IsEnabled() ) CosGen::AddColumns();
+	if ( primaries != "" )
+	{
+		G4String error;
+		if ( !PriFil::Open(primaries, error) )
+		{
+			std::cout << "'--primaries': " << error << "." << std::endl;
+			return 1;
+		}
+		std::cout << "mCP: " << PriFil::GetNEvents() << " events of primaries in " << primaries << std::endl;
+		RunAct::AddMeta("primary", "file:" + primaries);
+	}
+	else RunAct::AddMeta("primary", CosGen::IsEnabled() ? "cosmic:" + CosGen::GetSpectrum() : G4String("beam"));
+
+	// Photon thinning
+	// Optical photons are tracked with probability p and weight 1/p. Raw
+	// counts stay exact, and weighted counts of tracked photons are added.
+	if ( flag_thin )
+	{
+		if ( !(keep > 0. && keep <= 1.) || flag_s || flag_digitize || opticsMode == OptMap::kYield || opticsMode == OptMap::kTrace )
+		{
+			std::cout << "'--thin' needs a probability in (0, 1], and does not go with '-s', '--digitize' or '--optics yield' or 'trace'." << std::endl;
+			return 1;
+		}
+		StaAct::EnableThinning(keep);
+		RunAct::AddMeta("thinning", std::to_string(keep));
+	}
+
+	// Acceptance filter
+	// New photons which can hardly reach an end of the bar are killed, or
+	// kept with a larger weight. 'exact' keeps weighted counts unbiased, so
+	// it needs the weighted columns of thinning.
+	if ( acceptance != "" )
+	{
+		std::size_t colon = acceptance.find(':');
+		G4String modeName = acceptance.substr(0, colon);
+		double threshold = colon == std::string::npos ? 0.01 : atof(acceptance.substr(colon + 1).c_str());
+		AccFil::Mode mode = AccFil::kOff;
+		if      ( modeName == "exact" ) mode = AccFil::kExact;
+		else if ( modeName == "cut"   ) mode = AccFil::kCut;
+		if ( mode == AccFil::kOff || !(threshold > 0. && threshold <= 1.) || flag_s
+		  || opticsMode == OptMap::kYield || opticsMode == OptMap::kCalib || opticsMode == OptMap::kTrace
+		  || (mode == AccFil::kExact && flag_digitize) )
+		{
+			std::cout << "'--acceptance' needs exact or cut, and a threshold in (0, 1]. It does not go with '-s'," << std::endl;
+			std::cout << "'--optics yield', 'calib' or 'trace', and exact does not go with '--digitize'." << std::endl;
+			return 1;
+		}
+		if ( mode == AccFil::kExact && !flag_thin ) StaAct::EnableThinning(1.);
+		AccFil::Configure(mode, threshold);
+		RunAct::AddMeta("acceptance", modeName + ":" + std::to_string(threshold));
+	}
+
+	// Per-event profile columns: time, steps, stack depth, photons
+	if ( flag_profile ) EvePro::AddColumns();
+
 	// Randomizer
-	CLHEP::RanluxEngine defaultEngine(1234567, 4);
-	G4Random::setTheEngine(&defaultEngine);
-	G4int seed = time(NULL);
+	// Only the master engine is seeded here. In multithreaded mode the run
+	// manager draws the seeds of every worker (and event) from this engine.
+	// Without '--seed', the clock is used, and the seed is printed and
+	// recorded in the output file so the run can be reproduced.
+	CLHEP::HepRandomEngine* engine = CreateEngine(rngSpec);
+	if ( !engine )
+	{
+		std::cout << "Unknown random engine '" << rngSpec << "'. Try '-h'." << std::endl;
+		return 1;
+	}
+	G4Random::setTheEngine(engine);
+	if ( !flag_seed ) seed = time(NULL);
 	G4Random::setTheSeed(seed);
+	G4cout << "mCP: random engine " << engine -> name() << " (" << rngSpec << "), seed " << seed << G4endl;
+	RunAct::AddMeta("rngEngine", rngSpec);
+	RunAct::AddMeta("rngSeed", std::to_string(seed));
 
 	// Detect interactive mode (if flag_g) and define UI session
 	G4UIExecutive* UI = 0;
 	if ( flag_g ) UI = new G4UIExecutive(argc, argv);
 
 	// Run manager
-//	G4MTRunManager* RM = new G4MTRunManager();
-	G4RunManager* RM = new G4RunManager();
+	// Without '-t', the good old sequential run manager. With '-t N', the
+	// task-based one with N worker threads, and '-t 0' takes all cores.
+	// With '-s N', the sub-event parallel one: optical photons of an event are
+	// shipped to workers in batches of N.
+	G4RunManager* RM = 0;
+	if ( flag_s )
+	{
+#if G4VERSION_NUMBER >= 1130
+		if ( nThreads <= 0 ) nThreads = G4Threading::G4GetNumberOfCores();
+		if ( subEvtSize <= 0 ) subEvtSize = 10000;
+		RM = G4RunManagerFactory::CreateRunManager(G4RunManagerType::SubEvt);
+		RM -> SetNumberOfThreads(nThreads);
+		RM -> RegisterSubEventType(0, subEvtSize);
+		G4cout << "mCP: sub-event parallel mode with " << nThreads << " worker threads, "
+		       << subEvtSize << " photons per sub-event" << G4endl;
+#else
+		G4ExceptionDescription ed;
+		ed << "Sub-event parallel mode requires Geant4 11.3 or later.";
+		G4Exception("mCP::main", "mCP004", FatalException, ed);
+#endif
+	}
+	else if ( flag_t )
+	{
+		if ( nThreads <= 0 ) nThreads = G4Threading::G4GetNumberOfCores();
+		RM = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Tasking);
+		RM -> SetNumberOfThreads(nThreads);
+		G4cout << "mCP: running with " << nThreads << " worker threads" << G4endl;
+	}
+	else RM = G4RunManagerFactory::CreateRunManager(G4RunManagerType::SerialOnly);
 
 	// Detector construction from configuration (Geometry)
 	// We define everything about geomtrical setup in this class.
@@ -88,19 +483,73 @@ int main(int argc, char** argv)
 	RM -> SetUserInitialization(DC);
 
 	// Physics list to be used
-	G4VModularPhysicsList* PL = new QGSP_BERT;
+	G4VModularPhysicsList* PL = 0;
+	if ( physics == "full" )
+	{
+		PL = new QGSP_BERT;
+		PL -> ReplacePhysics(new G4EmStandardPhysics_option4());
+	}
+	else PL = new PhyLis(physics == "em4");
 	PL -> SetVerboseLevel(0);
-	PL -> ReplacePhysics(new G4EmStandardPhysics_option4());
 	G4OpticalPhysics* OP = new G4OpticalPhysics();
 	PL -> RegisterPhysics(OP);
+	if ( opticsMode == OptMap::kFast )
+	{
+		G4FastSimulationPhysics* FSP = new G4FastSimulationPhysics();
+		FSP -> ActivateFastSimulation("opticalphoton");
+		PL -> RegisterPhysics(FSP);
+	}
+	if ( opticsMode == OptMap::kYield )
+	{
+		G4OpticalParameters::Instance() -> SetProcessActivation("Scintillation", false);
+		G4OpticalParameters::Instance() -> SetProcessActivation("Cerenkov", false);
+	}
 	RM -> SetUserInitialization(PL);
 
 	// User actions
-	RM -> SetUserInitialization(new ActIni());
+	ActIni* AI = new ActIni();
+	AI -> SetPinAffinity(flag_p);
+	AI -> SetSubEvent(flag_s);
+	RM -> SetUserInitialization(AI);
 
 	// Initialize
 	RM -> Initialize();
 
+	// Physics tables are built at the first run, unless they are built (or
+	// taken from '--physics-cache') here. Benchmarks count them in.
+	G4String physicsTables = "deferred";
+	if ( PhyCac::IsEnabled() || bench != "" ) physicsTables = PhyCac::Build(RM, PL, optics);
+	initTimer.Stop();
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	G4cout << "mCP: initialization took " << initTimer.GetRealElapsed() << " s with physics " << physics
+	       << " (tables " << physicsTables << "), peak RSS " << usage.ru_maxrss / 1024. << " MB" << G4endl;
+
+	// Benchmark: run the workload and leave
+	if ( bench != "" )
+	{
+		G4int status = BenRun::Run(bench, physics, optics, seed, initTimer.GetRealElapsed(), physicsTables, benchRef);
+		delete RM;
+		delete engine;
+		AsyWri::Stop();
+		std::cout << "bye bye :)" << std::endl;
+		return status;
+	}
+
+	// Sharded job: fork here, after everything heavy is built. Children go on
+	// with the macro below, the parent only waits and merges.
+	if ( flag_j )
+	{
+		G4int shard = ShaJob::Fork(nShards, seed);
+		if ( shard < 0 )
+		{
+			delete RM;
+			delete engine;
+			std::cout << "bye bye :)" << std::endl;
+			return shard == -1 ? 0 : 1;
+		}
+	}
+
 	// Visualization manger
 	G4VisManager* VM = new G4VisExecutive();
 	VM -> Initialize();
@@ -145,6 +594,9 @@ int main(int argc, char** argv)
 	// in the main() program.
 	delete VM;
 	delete RM;
+	delete engine;
+	AsyWri::Stop();
+	PriFil::Close();
 
 	std::cout << "bye bye :)" << std::endl;
 
@@ -156,19 +608,104 @@ int main(int argc, char** argv)
 //////////////////////////////////////////////////
 void PrintHelp()
 {
-	std::cout << "usage: mCP [-b] [-g] [-m macrofile]" << std::endl;
+	std::cout << "usage: mCP [-b] [-g] [-m macrofile] [-t nThreads] [-p] [-s subEventSize] [-j nShards]" << std::endl;
+	std::cout << "           [--rng engine] [--seed seed] [--optics mode] [--map-dir dir]" << std::endl;
+	std::cout << "           [--output backend] [--async nBatches] [--profile] [--cost]" << std::endl;
+	std::cout << "           [--bench workload] [--bench-ref file] [--physics list] [--physics-cache dir]" << std::endl;
+	std::cout << "           [--materials file] [--sensors] [--digitize] [--cosmic spectrum]" << std::endl;
+	std::cout << "           [--primaries file] [--thin p] [--acceptance exact|cut[:threshold]]" << std::endl;
 	std::cout << std::endl;
 	std::cout << "Examples:" << std::endl;
-	std::cout << "  mCP -b -m myRun.mac  # Run in batch mode with macro and config." << std::endl;
-	std::cout << "  mCP -g               # Run in graphical mode."                   << std::endl;
+	std::cout << "  mCP -b -m myRun.mac       # Run in batch mode with macro and config." << std::endl;
+	std::cout << "  mCP -g                    # Run in graphical mode."                   << std::endl;
+	std::cout << "  mCP -b -m myRun.mac -t 0  # Run in batch mode on all cores."          << std::endl;
+	std::cout << "  mCP -m myRun.mac -j 8     # Run 8 shards of myRun.mac and merge."     << std::endl;
+	std::cout << "  mCP -b -m myRun.mac --optics calib  # Make optical map of the bar." << std::endl;
+	std::cout << "  mCP -b -m myRun.mac --optics fast   # Then use it."                 << std::endl;
+	std::cout << "  mCP --bench mu1GeV --optics yield   # Time a reference workload."   << std::endl;
 	std::cout << std::endl;
 	std::cout << "Options:" << std::endl;
 	std::cout << "  -b  Execute in batch mode"         << std::endl;
 	std::cout << "  -g  Execute in graphical mode"     << std::endl;
 	std::cout << "      Note: Default is command mode" << std::endl;
 	std::cout << "  -h  Show help message"             << std::endl;
+	std::cout << "  -j  Fork given number of shard processes after initialization" << std::endl;
+	std::cout << "      Note: Events of each /run/beamOn are split among the shards" << std::endl;
+	std::cout << "      Note: Each shard runs the macro with its own seed and file" << std::endl;
 	std::cout << "  -m  Run with macro"                << std::endl;
+	std::cout << "  -p  Pin worker threads to cores"   << std::endl;
+	std::cout << "  -s  Sub-event parallel mode with given photons per sub-event" << std::endl;
+	std::cout << "      Note: 0 means 10000. Needs Geant4 11.3 or later" << std::endl;
+	std::cout << "  -t  Number of worker threads"      << std::endl;
+	std::cout << "      Note: 0 means all cores. Default is sequential mode" << std::endl;
+	std::cout << "  --rng   Random engine: mixmax, ranlux[:luxury], mt" << std::endl;
+	std::cout << "          Note: luxury is 0 to 4. Default is ranlux:4" << std::endl;
+	std::cout << "  --seed  Master seed. Default is the current time" << std::endl;
+	std::cout << "  --optics   Optical photons in the bar: full, fast, calib, yield, trace" << std::endl;
+	std::cout << "             Note: Default is full. fast needs a map made by calib" << std::endl;
+	std::cout << "             Note: yield only counts photons from energy deposit" << std::endl;
+	std::cout << "             Note: trace traces photons through the box analytically, with the" << std::endl;
+	std::cout << "                   surface table made by calib. bench/trace.sh compares it with calib" << std::endl;
+	std::cout << "  --map-dir  Directory of optical maps. Default is ." << std::endl;
+	std::cout << "  --output   Output backend: root, col, summary" << std::endl;
+	std::cout << "             Note: col files are read with tools/mcpcol" << std::endl;
+	std::cout << "             Note: summary writes histograms only, to a .sum text file" << std::endl;
+	std::cout << "             Note: summary does not go with '-j'" << std::endl;
+	std::cout << "  --async    Write col output on its own thread, with given batches in flight" << std::endl;
+	std::cout << "             Note: A batch is 65536 events" << std::endl;
+	std::cout << "             Note: A crash loses the batches in flight and those being filled" << std::endl;
+	std::cout << "  --profile  Add per-event time, step, stack and photon columns" << std::endl;
+	std::cout << "  --cost     Print step time by process and volume at end of run" << std::endl;
+	std::cout << "  --bench    Run a reference workload and print its throughput as JSON" << std::endl;
+	std::cout << "             Note: mu1GeV, mu100MeV, mu1GeVAngled. Seed is 12345 by default" << std::endl;
+	std::cout << "             Note: bench/suite.sh runs them all, and is the mCP_bench target" << std::endl;
+	std::cout << "  --bench-ref  Reference photon counts. Default is bench/reference.txt" << std::endl;
+	std::cout << "  --physics  Physics list: full, em4, em0" << std::endl;
+	std::cout << "             Note: Default is full, QGSP_BERT with EM option4" << std::endl;
+	std::cout << "             Note: em4 and em0 are EM option4 or standard EM, decay and optics only" << std::endl;
+	std::cout << "  --materials  Materials and optical surfaces. Default is materials/mCP.mat" << std::endl;
+	std::cout << "               Note: The installed one is used if there is none here" << std::endl;
+	std::cout << "  --sensors    Photosensors on both bar ends, with per-end hits and first arrival time" << std::endl;
+	std::cout << "               Note: Photons are then tracked to them instead of killed" << std::endl;
+	std::cout << "  --digitize   Add amplitude, threshold and CFD time of a sampled waveform of each end" << std::endl;
+	std::cout << "               Note: Needs --sensors, or --optics fast or calib. See /mCP/digi/" << std::endl;
+	std::cout << "  --cosmic     Cosmic muons through a plane above the bar instead of the beam" << std::endl;
+	std::cout << "               Note: Spectrum is reyna, gaisser (only muons above 100 GeV / cos(zenith))" << std::endl;
+	std::cout << "                     or a table of" << std::endl;
+	std::cout << "                     'energy/GeV cos(zenith) intensity'" << std::endl;
+	std::cout << "               Note: Muons missing the bar are drawn again. See /mCP/cosmic/" << std::endl;
+	std::cout << "  --primaries  Read primaries of every event from a file instead of the beam" << std::endl;
+	std::cout << "               Note: Make it with tools/mcppri. Events read entries in order," << std::endl;
+	std::cout << "                     and every run goes on where the last one stopped" << std::endl;
+	std::cout << "  --thin       Track optical photons with given probability and weight 1/p" << std::endl;
+	std::cout << "               Note: Adds weighted counts w* and their thinning variance v*" << std::endl;
+	std::cout << "               Note: bench/thin.sh compares it with full tracking. See /mCP/stack/" << std::endl;
+	std::cout << "  --acceptance  Kill new photons whose bound of arriving at an end is below threshold" << std::endl;
+	std::cout << "                Note: exact keeps them with probability bound/threshold and weights them" << std::endl;
+	std::cout << "                Note: cut kills them, and accLost bounds the photons lost. Default threshold 0.01" << std::endl;
+	std::cout << "                Note: Only for a bare polished bar; off with a rough or wrapped surface" << std::endl;
+	std::cout << "  --physics-cache  Keep physics tables in given directory, and start from them next time" << std::endl;
+	std::cout << "                   Note: Entries are keyed by physics, cuts and materials" << std::endl;
 	std::cout << std::endl;
 	std::cout << "bye bye :)" << std::endl;
 	std::cout << std::endl;
 }
+
+//////////////////////////////////////////////////
+//   Create random engine
+//////////////////////////////////////////////////
+CLHEP::HepRandomEngine* CreateEngine(const G4String& spec)
+{
+	// Seeds given here are overwritten by setTheSeed() anyway
+	if ( spec == "mixmax" ) return new CLHEP::MixMaxRng();
+	if ( spec == "mt"     ) return new CLHEP::MTwistEngine();
+
+	if ( spec == "ranlux" ) return new CLHEP::RanluxEngine(1234567, 4);
+	if ( spec.size() == 8 && spec.substr(0, 7) == "ranlux:" )
+	{
+		int luxury = spec[7] - '0';
+		if ( luxury >= 0 && luxury <= 4 ) return new CLHEP::RanluxEngine(1234567, luxury);
+	}
+
+	return 0;
+}
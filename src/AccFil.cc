@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+//   AccFil.cc
+//
+//   Definitions of AccFil class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4Box.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4LogicalBorderSurface.hh"
+#include "G4OpticalSurface.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include "AccFil.hh"
+#include "EveAct.hh"
+#include "RunAct.hh"
+
+AccFil::Mode AccFil::s_Mode = AccFil::kOff;
+G4double AccFil::s_Threshold = 0.01;
+
+namespace
+{
+	// s-polarized Fresnel reflectance from inside (n) to outside (nOut), at
+	// the given cosine of incidence. It is never below the p-polarized one,
+	// so it bounds the reflectance of any polarization.
+	inline G4double ReflectanceS(G4double n, G4double nOut, G4double cosI)
+	{
+		if ( nOut <= 0. ) return 0.;
+		G4double sinT2 = (n / nOut) * (n / nOut) * (1. - cosI * cosI);
+		if ( sinT2 >= 1. ) return 1.;
+		G4double cosT = std::sqrt(1. - sinT2);
+		G4double r = (n * cosI - nOut * cosT) / (n * cosI + nOut * cosT);
+		return r * r;
+	}
+
+	// Properties which change the direction of a photon inside a volume
+	const char* Scatterers[] = {"RAYLEIGH", "MIEHG", "WLSABSLENGTH", "WLSABSLENGTH2"};
+
+	G4bool Scatters(const G4Material* mat)
+	{
+		G4MaterialPropertiesTable* MPT = mat -> GetMaterialPropertiesTable();
+		if ( !MPT ) return false;
+		for ( const char* prop: Scatterers )
+			if ( MPT -> GetProperty(prop) ) return true;
+		return false;
+	}
+}
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+AccFil::AccFil(EveAct* EA): m_EA(EA)
+{
+	m_Active = false;
+	m_SciPV = 0;
+	m_Half[0] = m_Half[1] = m_Half[2] = 0.;
+	m_RIndex = 0;
+	m_AbsLength = 0;
+	m_OutRIndex = 0;
+	m_OptPho = G4OpticalPhoton::Definition();
+}
+
+AccFil::~AccFil()
+{
+}
+
+//////////////////////////////////////////////////
+//   Process-wide settings
+//////////////////////////////////////////////////
+void AccFil::Configure(Mode mode, G4double threshold)
+{
+	s_Mode = mode;
+	s_Threshold = threshold;
+	if ( mode == kOff ) return;
+
+	// Photons killed by the filter, and the sum of their bounds
+	RunAct::AddColumn("accKilled", 'I');
+	RunAct::AddColumn("accLost", 'D');
+}
+
+AccFil::Mode AccFil::GetMode()
+{
+	return s_Mode;
+}
+
+//////////////////////////////////////////////////
+//   Begin of run
+//////////////////////////////////////////////////
+void AccFil::BeginOfRun()
+{
+	m_Active = false;
+
+	// The bar, and the lab around it
+	G4PhysicalVolumeStore* PVS = G4PhysicalVolumeStore::GetInstance();
+	m_SciPV = PVS -> GetVolume("SciPV", false);
+	const G4VPhysicalVolume* labPV = PVS -> GetVolume("LabPV", false);
+	const G4Box* sciBox = m_SciPV ? dynamic_cast<const G4Box*>(m_SciPV -> GetLogicalVolume() -> GetSolid()) : 0;
+	if ( !sciBox || !labPV )
+	{
+		G4Exception("mCP::AccFil", "mCP015", JustWarning, "No bar box in the lab. Acceptance filter is off.");
+		return;
+	}
+	m_Half[0] = sciBox -> GetXHalfLength();
+	m_Half[1] = sciBox -> GetYHalfLength();
+	m_Half[2] = sciBox -> GetZHalfLength();
+	m_Center = m_SciPV -> GetTranslation() + labPV -> GetTranslation();
+
+	// The bound holds only if nothing turns a photon but the side faces, and
+	// a photon leaving through a side never comes back to an end: no
+	// rotation, nothing scattering, and the other volumes in the lab (the
+	// photosensors) within the end faces.
+	G4String why = "";
+	if ( m_SciPV -> GetRotation() || labPV -> GetRotation() ) why = "the bar is rotated";
+	else if ( Scatters(m_SciPV -> GetLogicalVolume() -> GetMaterial()) ) why = "photons scatter in the bar";
+	else if ( Scatters(labPV -> GetLogicalVolume() -> GetMaterial()) ) why = "photons scatter in the lab";
+	const G4LogicalVolume* labLV = labPV -> GetLogicalVolume();
+	for ( std::size_t i = 0; why == "" && i < labLV -> GetNoDaughters(); i++ )
+	{
+		const G4VPhysicalVolume* PV = labLV -> GetDaughter(i);
+		if ( PV == m_SciPV ) continue;
+		const G4Box* box = dynamic_cast<const G4Box*>(PV -> GetLogicalVolume() -> GetSolid());
+		G4ThreeVector pos = PV -> GetTranslation() - m_SciPV -> GetTranslation();
+		if ( !box || PV -> GetRotation()
+		  || std::abs(pos.x()) + box -> GetXHalfLength() > m_Half[0] * (1. + 1.e-9)
+		  || std::abs(pos.y()) + box -> GetYHalfLength() > m_Half[1] * (1. + 1.e-9) )
+			why = PV -> GetName() + " is beside the bar";
+	}
+
+	// Side faces: bare polished dielectric, or no surface at all
+	const G4LogicalBorderSurface* LBS = G4LogicalBorderSurface::GetSurface(m_SciPV, labPV);
+	const G4OpticalSurface* opS = LBS ? dynamic_cast<const G4OpticalSurface*>(LBS -> GetSurfaceProperty()) : 0;
+	if ( why == "" && LBS )
+	{
+		G4bool bare = opS && opS -> GetType() == dielectric_dielectric && opS -> GetFinish() == polished
+		           && ( opS -> GetModel() == unified || opS -> GetPolish() >= 1. );
+		if ( !bare ) why = "the bar surface is not polished dielectric_dielectric";
+	}
+
+	if ( why != "" )
+	{
+		G4ExceptionDescription ed;
+		ed << "Photon directions are not kept in the bar: " << why << ". Acceptance filter is off.";
+		G4Exception("mCP::AccFil", "mCP015", JustWarning, ed);
+		return;
+	}
+
+	// Optical properties. Without RINDEX in the bar, photons are never made.
+	G4MaterialPropertiesTable* sciMPT = m_SciPV -> GetLogicalVolume() -> GetMaterial() -> GetMaterialPropertiesTable();
+	G4MaterialPropertiesTable* labMPT = labLV -> GetMaterial() -> GetMaterialPropertiesTable();
+	m_RIndex = sciMPT ? sciMPT -> GetProperty("RINDEX") : 0;
+	m_AbsLength = sciMPT ? sciMPT -> GetProperty("ABSLENGTH") : 0;
+	m_OutRIndex = labMPT ? labMPT -> GetProperty("RINDEX") : 0;
+	m_Active = m_RIndex != 0;
+}
+
+//////////////////////////////////////////////////
+//   Filter photons of a step
+//////////////////////////////////////////////////
+void AccFil::Filter(const G4Step* step)
+{
+	if ( !m_Active || step -> GetTrack() -> GetDefinition() == m_OptPho ) return;
+	const std::vector<const G4Track*>* secondaries = step -> GetSecondaryInCurrentStep();
+	if ( !secondaries || secondaries -> empty() ) return;
+
+	// Gather photons inside the bar, in its frame. Buffers keep their
+	// capacity, so this allocates only for the largest step so far.
+	std::size_t size = secondaries -> size();
+	if ( m_Tracks.size() < size )
+	{
+		m_Tracks.resize(size);
+		for ( G4int k = 0; k < 3; k++ )
+		{
+			m_Pos[k].resize(size);
+			m_Dir[k].resize(size);
+		}
+		m_N.resize(size);
+		m_NOut.resize(size);
+		m_AbsLen.resize(size);
+		m_Path.resize(size);
+		m_U.resize(size);
+		m_Rand.resize(size);
+	}
+	std::size_t n = 0;
+	for ( const G4Track* track: *secondaries )
+	{
+		if ( track -> GetDefinition() != m_OptPho ) continue;
+		G4ThreeVector pos = track -> GetPosition() - m_Center;
+		if ( std::abs(pos.x()) > m_Half[0] || std::abs(pos.y()) > m_Half[1] || std::abs(pos.z()) > m_Half[2] ) continue;
+		const G4ThreeVector& dir = track -> GetMomentumDirection();
+		G4double energy = track -> GetKineticEnergy();
+
+		m_Tracks[n] = const_cast<G4Track*>(track);
+		for ( G4int k = 0; k < 3; k++ )
+		{
+			m_Pos[k][n] = pos[k];
+			m_Dir[k][n] = dir[k];
+		}
+		m_N[n] = m_RIndex -> Value(energy);
+		m_NOut[n] = m_OutRIndex ? m_OutRIndex -> Value(energy) : 0.;
+		m_AbsLen[n] = m_AbsLength ? m_AbsLength -> Value(energy) : DBL_MAX;
+		n++;
+	}
+	if ( n == 0 ) return;
+
+	ComputeBounds(n);
+
+	// Photons below the threshold
+	const G4double thr = s_Threshold;
+	if ( s_Mode == kExact ) G4Random::getTheEngine() -> flatArray(n, m_Rand.data());
+	for ( std::size_t i = 0; i < n; i++ )
+	{
+		G4double U = m_U[i];
+		if ( U >= thr ) continue;
+		G4Track* track = m_Tracks[i];
+
+		// Russian roulette: kept with probability U/thr, and its weight makes
+		// up for the others. A photon with U = 0 never arrives.
+		if ( s_Mode == kExact )
+		{
+			G4double q = U / thr;
+			if ( m_Rand[i] < q )
+			{
+				track -> SetWeight(track -> GetWeight() / q);
+				continue;
+			}
+			U = 0.;
+		}
+
+		// Killed: StaAct counts it, and does not track it.
+		track -> SetWeight(0.);
+		m_EA -> AddFiltered(U);
+	}
+}
+
+//////////////////////////////////////////////////
+//   Upper bounds of arrival
+//////////////////////////////////////////////////
+void AccFil::ComputeBounds(std::size_t n)
+{
+	const G4double* x[3] = {m_Pos[0].data(), m_Pos[1].data(), m_Pos[2].data()};
+	const G4double* d[3] = {m_Dir[0].data(), m_Dir[1].data(), m_Dir[2].data()};
+	const G4double* nIn = m_N.data();
+	const G4double* nOut = m_NOut.data();
+	const G4double* absLen = m_AbsLen.data();
+	G4double* path = m_Path.data();
+	G4double* U = m_U.data();
+	const G4double halfZ = m_Half[2];
+
+	// Path to the end ahead, and absorption on the way, as log U. A photon
+	// going sideways never arrives.
+	for ( std::size_t i = 0; i < n; i++ )
+	{
+		G4double dz = std::abs(d[2][i]);
+		G4bool ahead = dz > 1.e-9;
+		path[i] = ahead ? (halfZ - (d[2][i] < 0. ? -x[2][i] : x[2][i])) / dz : 0.;
+		U[i] = ahead ? -path[i] / absLen[i] : -DBL_MAX;
+	}
+
+	// Reflections on each pair of side faces. On the unfolded path, the k-th
+	// face is met after (half - x) + 2 (k - 1) half along the axis, with x
+	// signed along the direction. Rounding
+	// down keeps the count from being too high.
+	for ( G4int axis = 0; axis < 2; axis++ )
+	{
+		const G4double half = m_Half[axis];
+		for ( std::size_t i = 0; i < n; i++ )
+		{
+			G4double c = std::abs(d[axis][i]);
+			G4double travel = c * path[i];
+			G4double xAhead = d[axis][i] < 0. ? -x[axis][i] : x[axis][i];
+			G4double hits = std::floor((travel + xAhead + half) / (2. * half) - 1.e-9);
+			if ( hits < 1. ) continue;
+			G4double R = ReflectanceS(nIn[i], nOut[i], c);
+			U[i] = R > 0. ? U[i] + hits * std::log(R) : -DBL_MAX;
+		}
+	}
+
+	for ( std::size_t i = 0; i < n; i++ ) U[i] = U[i] > -700. ? std::exp(U[i]) : 0.;
+}
@@ -7,17 +7,26 @@
 //                       - 18. Dec. 2023. Hoyong Jeong (hoyong5419@korea.ac.kr)
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "G4Threading.hh"
+
 #include "ActIni.hh"
 #include "PriGenAct.hh"
 #include "RunAct.hh"
 #include "EveAct.hh"
 #include "SteAct.hh"
+#include "StaAct.hh"
 
 //////////////////////////////////////////////////
 //   Constructor
 //////////////////////////////////////////////////
 ActIni::ActIni(): G4VUserActionInitialization()
 {
+	m_Pin = false;
+	m_SubEvent = false;
 }
 
 //////////////////////////////////////////////////
@@ -34,20 +43,84 @@ void ActIni::BuildForMaster() const
 {
 	// So, this part is for master. This program is possible to do multithread.
 	// A thread will care things as a master.
-	SetUserAction(new RunAct());
+	// In sub-event parallel mode, the master processes events by itself and
+	// only optical photons go to workers. So it needs every action.
+	if ( m_SubEvent ) BuildActions(false);
+	else SetUserAction(new RunAct());
 }
 
 //////////////////////////////////////////////////
 //   Build
 //////////////////////////////////////////////////
 void ActIni::Build() const
+{
+	// This is called once in every worker thread, so it is a good place to
+	// pin the thread. Everything built below is owned by this thread only.
+	if ( m_Pin ) PinThisThread();
+
+	BuildActions(true);
+}
+
+//////////////////////////////////////////////////
+//   Build actions
+//////////////////////////////////////////////////
+void ActIni::BuildActions(G4bool isWorker) const
 {
 	// All user actions are here.
-	SetUserAction(new PriGenAct());
-	SetUserAction(new RunAct());
+	PriGenAct* PGA = new PriGenAct();
+	SetUserAction(PGA);
 
 	EveAct* EA = new EveAct();
+	EA -> SetCosGen(PGA -> GetCosGen());
+	if ( m_SubEvent ) EA -> SetSubEventMode(isWorker);
 	SetUserAction(EA);
 
-	SetUserAction(new SteAct(EA));
+	SteAct* SA = new SteAct(EA);
+	SetUserAction(SA);
+
+	StaAct* StA = new StaAct(EA);
+	StA -> SetBoxTracer(SA -> GetBoxTracer());
+	if ( m_SubEvent && !isWorker ) StA -> SetShipPhotons(true);
+	SetUserAction(StA);
+
+	SetUserAction(new RunAct(SA, EA));
+}
+
+//////////////////////////////////////////////////
+//   Thread pinning
+//////////////////////////////////////////////////
+void ActIni::SetPinAffinity(G4bool pin)
+{
+	m_Pin = pin;
+}
+
+//////////////////////////////////////////////////
+//   Sub-event parallel mode
+//////////////////////////////////////////////////
+void ActIni::SetSubEvent(G4bool subEvent)
+{
+	m_SubEvent = subEvent;
+}
+
+void ActIni::PinThisThread() const
+{
+	G4int threadID = G4Threading::G4GetThreadId();
+	if ( threadID < 0 ) return; // Sequential mode or master
+
+#ifdef __linux__
+	G4int core = threadID % G4Threading::G4GetNumberOfCores();
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(core, &cpuSet);
+	if ( sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0 )
+	{
+		G4ExceptionDescription ed;
+		ed << "Failed to pin worker thread " << threadID << " to core " << core << ".";
+		G4Exception("mCP::ActIni", "mCP003", JustWarning, ed);
+	}
+#else
+	G4ExceptionDescription ed;
+	ed << "Thread pinning is only supported on Linux.";
+	G4Exception("mCP::ActIni", "mCP003", JustWarning, ed);
+#endif
 }
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+//   AsyWri.cc
+//
+//   Definitions of AsyWri class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "AsyWri.hh"
+#include "ColWri.hh"
+#include "BatQue.hh"
+
+namespace
+{
+	// A full batch and the file it goes to. The last batch of a file was
+	// not taken from the spares, so it is not returned there.
+	struct Job
+	{
+		ColWri* CW;
+		ColBat* batch;
+		bool last;
+	};
+
+	G4int nBatches = 0;
+
+	// Spare batches, and full ones on their way to the writer
+	BatQue<ColBat>* spares = 0;
+	BatQue<Job>* jobs = 0;
+
+	std::atomic<std::thread*> writer(0);
+	std::mutex startMutex;
+	std::atomic<bool> stop(false);
+
+	// Signalled whenever the writer is done with a batch, for Wait()
+	std::mutex doneMutex;
+	std::condition_variable doneCond;
+}
+
+//////////////////////////////////////////////////
+//   Enable
+//////////////////////////////////////////////////
+void AsyWri::Enable(G4int n)
+{
+	nBatches = n > 2 ? n : 2;
+}
+
+G4bool AsyWri::IsEnabled()
+{
+	return nBatches > 0;
+}
+
+//////////////////////////////////////////////////
+//   Start and stop
+//////////////////////////////////////////////////
+void AsyWri::Start()
+{
+	std::lock_guard<std::mutex> lock(startMutex);
+	if ( writer ) return;
+
+	spares = new BatQue<ColBat>(nBatches);
+	jobs = new BatQue<Job>(2 * nBatches);
+	for ( G4int i = 0; i < nBatches; i++ ) spares -> Push(new ColBat());
+
+	stop = false;
+	writer = new std::thread(&AsyWri::Loop);
+}
+
+void AsyWri::Stop()
+{
+	if ( !writer ) return;
+
+	// Files are closed at the end of every run, so the queue is empty by
+	// now. The writer drains it anyway before it looks at the flag.
+	stop = true;
+	jobs -> Wake();
+	writer.load() -> join();
+	delete writer.load();
+	writer = 0;
+
+	ColBat* batch;
+	while ( spares -> Pop(batch) ) delete batch;
+	delete spares;
+	delete jobs;
+	spares = 0;
+	jobs = 0;
+}
+
+//////////////////////////////////////////////////
+//   Event thread side
+//////////////////////////////////////////////////
+ColBat* AsyWri::Acquire(const std::vector<char>& types)
+{
+	if ( !writer ) Start();
+
+	// Back pressure: every batch is in flight, so the disk is the bottleneck.
+	// None after Stop(): the caller writes on its own then.
+	ColBat* batch = 0;
+	if ( !spares -> PopWait(batch, stop) ) return 0;
+
+	if ( batch -> iBuf.size() != types.size() ) batch -> Shape(types);
+	batch -> nRows = 0;
+	return batch;
+}
+
+void AsyWri::Submit(ColWri* CW, ColBat* batch, G4bool last)
+{
+	if ( !writer ) Start();
+
+	// One small allocation per block of rows
+	Job* job = new Job{CW, batch, last};
+	jobs -> PushWait(job);
+}
+
+void AsyWri::Wait(const std::atomic<G4int>& counter)
+{
+	std::unique_lock<std::mutex> lock(doneMutex);
+	doneCond.wait(lock, [&] { return counter.load() <= 0; });
+}
+
+//////////////////////////////////////////////////
+//   Writer thread
+//////////////////////////////////////////////////
+void AsyWri::Loop()
+{
+	// Sleeps until there is a job. Stop() wakes it when the queue is empty.
+	Job* job;
+	for ( ;; )
+	{
+		if ( !jobs -> PopWait(job, stop) ) return;
+
+		job -> CW -> WriteBlock(*job -> batch);
+		if ( job -> last ) delete job -> batch;
+		else
+		{
+			// Can be full for a moment, until the owner of this batch takes
+			// its spare.
+			job -> batch -> nRows = 0;
+			spares -> PushWait(job -> batch);
+		}
+		job -> CW -> BatchDone();
+		delete job;
+
+		{ std::lock_guard<std::mutex> lock(doneMutex); }
+		doneCond.notify_all();
+	}
+}
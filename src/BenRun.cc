@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////
+//   BenRun.cc
+//
+//   Definitions of BenRun class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <sys/resource.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "BenRun.hh"
+#include "RunAct.hh"
+#include "EveAct.hh"
+#include "SteAct.hh"
+
+namespace
+{
+	// Reference workloads. Every one crosses the bar: the gun sits 1 m from
+	// the centre of the bar and points at it.
+	struct Workload
+	{
+		const char* name;
+		const char* description;
+		G4double energy;   // Kinetic energy of mu-
+		G4double angle;    // From the bar axis, in the xz plane
+		G4int nEvents;
+	};
+
+	const std::vector<Workload> workloads =
+	{
+		{"mu1GeV"      , "1 GeV mu- along the bar (default setup)", 1000. * MeV,  0. * deg, 20},
+		{"mu100MeV"    , "100 MeV mu- along the bar, stops inside",  100. * MeV,  0. * deg, 50},
+		{"mu1GeVAngled", "1 GeV mu- at 30 deg through the bar"    , 1000. * MeV, 30. * deg, 50},
+	};
+
+	// Pull above which the photon counts disagree
+	const G4double maxPull = 5.;
+}
+
+//////////////////////////////////////////////////
+//   Workloads
+//////////////////////////////////////////////////
+G4bool BenRun::Has(const G4String& workload)
+{
+	for ( const auto& w: workloads )
+		if ( workload == w.name ) return true;
+
+	return false;
+}
+
+void BenRun::PrintWorkloads()
+{
+	for ( const auto& w: workloads )
+		std::printf("  %-14s %s, %d events\n", w.name, w.description, w.nEvents);
+}
+
+//////////////////////////////////////////////////
+//   Run
+//////////////////////////////////////////////////
+G4int BenRun::Run(const G4String& workload, const G4String& physics, const G4String& optics, G4long seed,
+                  G4double initTime, const G4String& physicsTables, const G4String& refFile)
+{
+	const Workload* w = 0;
+	for ( const auto& ww: workloads )
+		if ( workload == ww.name ) w = &ww;
+	if ( !w ) return 1;
+
+	// Gun through the built-in particle gun commands
+	G4ThreeVector dir(std::sin(w -> angle), 0., std::cos(w -> angle));
+	G4ThreeVector pos = - 1000. * mm * dir;
+	std::ostringstream cmd;
+	G4UImanager* UM = G4UImanager::GetUIpointer();
+	UM -> ApplyCommand("/control/verbose 0");
+	UM -> ApplyCommand("/run/verbose 0");
+	UM -> ApplyCommand("/event/verbose 0");
+	UM -> ApplyCommand("/tracking/verbose 0");
+	UM -> ApplyCommand("/gun/particle mu-");
+	cmd << "/gun/energy " << w -> energy / MeV << " MeV";
+	UM -> ApplyCommand(cmd.str());
+	cmd.str("");
+	cmd << "/gun/direction " << dir.x() << " " << dir.y() << " " << dir.z();
+	UM -> ApplyCommand(cmd.str());
+	cmd.str("");
+	cmd << "/gun/position " << pos.x() / mm << " " << pos.y() / mm << " " << pos.z() / mm << " mm";
+	UM -> ApplyCommand(cmd.str());
+
+	G4RunManager* RM = G4RunManager::GetRunManager();
+	RM -> BeamOn(w -> nEvents);
+
+	// Everything of the run is in the actions of this (only) thread.
+	const RunAct* RA = dynamic_cast<const RunAct*>(RM -> GetUserRunAction());
+	const EveAct* EA = dynamic_cast<const EveAct*>(RM -> GetUserEventAction());
+	const SteAct* SA = dynamic_cast<const SteAct*>(RM -> GetUserSteppingAction());
+	if ( !RA || !EA || !SA ) return 1;
+
+	G4double runTime = RA -> GetRealTime();
+	G4double stat[4];
+	G4int nEvents = EA -> GetSummary(stat[0], stat[1], stat[2], stat[3]);
+	G4double nPhotons = (stat[0] + stat[2]) * nEvents;
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	G4double peakRSS = usage.ru_maxrss / 1024.; // kB on Linux
+
+	// Physics check
+	G4double ref[4];
+	G4bool hasRef = FindReference(refFile, workload, optics, ref);
+	G4double pull[2] = {0., 0.};
+	G4bool pass = true;
+	for ( G4int i = 0; hasRef && i < 2; i++ )
+	{
+		G4double err = std::sqrt(stat[2 * i + 1] * stat[2 * i + 1] + ref[2 * i + 1] * ref[2 * i + 1]);
+		G4double diff = stat[2 * i] - ref[2 * i];
+		pull[i] = err > 0. ? diff / err : (diff == 0. ? 0. : HUGE_VAL);
+		if ( std::abs(pull[i]) > maxPull ) pass = false;
+	}
+
+	// One line of JSON, and one line for bench/reference.txt
+	char line[1024];
+	auto counts = [&](G4int i) -> std::string
+	{
+		char buf[256];
+		if ( hasRef )
+			std::snprintf(buf, sizeof(buf), "{\"mean\": %.6g, \"err\": %.6g, \"ref\": %.6g, \"refErr\": %.6g, \"pull\": %.3g}",
+			              stat[2 * i], stat[2 * i + 1], ref[2 * i], ref[2 * i + 1], pull[i]);
+		else
+			std::snprintf(buf, sizeof(buf), "{\"mean\": %.6g, \"err\": %.6g, \"ref\": null}", stat[2 * i], stat[2 * i + 1]);
+		return buf;
+	};
+	std::snprintf(line, sizeof(line),
+	              "{\"bench\": \"%s\", \"physics\": \"%s\", \"optics\": \"%s\", \"seed\": %ld, \"events\": %d, "
+	              "\"initTime_s\": %.3f, \"physicsTables\": \"%s\", \"runTime_s\": %.3f, \"events_per_s\": %.4g, \"steps_per_s\": %.4g, "
+	              "\"photons_per_s\": %.4g, \"peakRSS_MB\": %.1f, \"nScint\": %s, \"nCeren\": %s, \"check\": \"%s\"}",
+	              workload.c_str(), physics.c_str(), optics.c_str(), seed, nEvents,
+	              initTime, physicsTables.c_str(), runTime, runTime > 0. ? nEvents / runTime : 0., runTime > 0. ? SA -> GetNSteps() / runTime : 0.,
+	              runTime > 0. ? nPhotons / runTime : 0., peakRSS, counts(0).c_str(), counts(1).c_str(),
+	              !hasRef ? "none" : (pass ? "pass" : "fail"));
+	G4cout << line << G4endl;
+	std::snprintf(line, sizeof(line), "mCP-bench-ref: %s %s %.9g %.9g %.9g %.9g",
+	              workload.c_str(), optics.c_str(), stat[0], stat[1], stat[2], stat[3]);
+	G4cout << line << G4endl;
+
+	return pass ? 0 : 2;
+}
+
+//////////////////////////////////////////////////
+//   Reference
+//////////////////////////////////////////////////
+G4bool BenRun::FindReference(const G4String& refFile, const G4String& workload, const G4String& optics,
+                             G4double ref[4])
+{
+	// <workload> <optics> <nScint> <nScintErr> <nCeren> <nCerenErr>
+	std::ifstream file(refFile);
+	std::string line;
+	while ( std::getline(file, line) )
+	{
+		if ( line.empty() || line[0] == '#' ) continue;
+		std::istringstream iss(line);
+		std::string w, o;
+		if ( !(iss >> w >> o >> ref[0] >> ref[1] >> ref[2] >> ref[3]) ) continue;
+		if ( w == workload && o == optics ) return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+//   BoxTra.cc
+//
+//   Definitions of BoxTra class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#include "G4Track.hh"
+#include "G4Box.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include "BoxTra.hh"
+#include "SurTab.hh"
+#include "EveAct.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+BoxTra::BoxTra(EveAct* EA): m_EA(EA)
+{
+	m_ST = 0;
+	m_Half[0] = m_Half[1] = m_Half[2] = 0.;
+	m_AbsLength = 0;
+	m_GroupVel = 0;
+	m_RIndex = 0;
+
+	// Buffers of a full batch, allocated once
+	m_N = 0;
+	for ( G4int k = 0; k < 3; k++ )
+	{
+		m_Pos[k].resize(s_BatchSize);
+		m_Dir[k].resize(s_BatchSize);
+	}
+	m_Time   .resize(s_BatchSize);
+	m_Path   .resize(s_BatchSize);
+	m_AbsLeft.resize(s_BatchSize);
+	m_InvVel .resize(s_BatchSize);
+	m_Weight .resize(s_BatchSize);
+	m_Step   .resize(s_BatchSize);
+	m_Face   .resize(s_BatchSize);
+	m_Rand   .resize(4 * s_BatchSize);
+
+	m_NPhotons = 0;
+	m_NHits = 0;
+	m_Wall = 0.;
+}
+
+BoxTra::~BoxTra()
+{
+}
+
+//////////////////////////////////////////////////
+//   Begin and end of run
+//////////////////////////////////////////////////
+void BoxTra::BeginOfRun()
+{
+	m_ST = 0;
+	m_N = 0;
+	m_NPhotons = 0;
+	m_NHits = 0;
+	m_Wall = 0.;
+
+	const G4VPhysicalVolume* sciPV = G4PhysicalVolumeStore::GetInstance() -> GetVolume("SciPV", false);
+	const G4VPhysicalVolume* labPV = G4PhysicalVolumeStore::GetInstance() -> GetVolume("LabPV", false);
+	const G4Box* box = sciPV ? dynamic_cast<const G4Box*>(sciPV -> GetLogicalVolume() -> GetSolid()) : 0;
+	if ( !box || !labPV || sciPV -> GetRotation() || labPV -> GetRotation() )
+	{
+		G4Exception("mCP::BoxTra", "mCP017", JustWarning, "No upright bar box in the lab. Photons are tracked in full.");
+		return;
+	}
+	m_Half[0] = box -> GetXHalfLength();
+	m_Half[1] = box -> GetYHalfLength();
+	m_Half[2] = box -> GetZHalfLength();
+	m_Center = sciPV -> GetTranslation() + labPV -> GetTranslation();
+
+	G4MaterialPropertiesTable* MPT = sciPV -> GetLogicalVolume() -> GetMaterial() -> GetMaterialPropertiesTable();
+	if ( MPT && ( MPT -> GetProperty("RAYLEIGH") || MPT -> GetProperty("MIEHG") || MPT -> GetProperty("WLSABSLENGTH") ) )
+	{
+		G4Exception("mCP::BoxTra", "mCP017", JustWarning, "Photons scatter or shift in the bar. Photons are tracked in full.");
+		return;
+	}
+	m_AbsLength = MPT ? MPT -> GetProperty("ABSLENGTH") : 0;
+	m_GroupVel = MPT ? MPT -> GetProperty("GROUPVEL") : 0;
+	m_RIndex = MPT ? MPT -> GetProperty("RINDEX") : 0;
+
+	// Master loaded it for this bar, see RunAct.
+	m_ST = SurTab::GetShared();
+}
+
+void BoxTra::EndOfRun()
+{
+	if ( m_NPhotons == 0 || m_Wall <= 0. ) return;
+	G4cout << "mCP: box tracer " << m_NPhotons << " photons, " << m_NHits << " side face hits in " << m_Wall << " s ("
+	       << m_NPhotons / m_Wall << " photons/s, " << m_NHits / m_Wall << " hits/s)" << G4endl;
+}
+
+//////////////////////////////////////////////////
+//   Add, flush and clear
+//////////////////////////////////////////////////
+void BoxTra::Add(const G4Track* track)
+{
+	std::size_t i = m_N;
+	G4ThreeVector pos = track -> GetPosition() - m_Center;
+	const G4ThreeVector& dir = track -> GetMomentumDirection();
+	G4double energy = track -> GetKineticEnergy();
+	for ( G4int k = 0; k < 3; k++ )
+	{
+		m_Pos[k][i] = pos[k];
+		m_Dir[k][i] = dir[k];
+	}
+	m_Time[i] = track -> GetGlobalTime();
+	m_Path[i] = 0.;
+	m_AbsLeft[i] = m_AbsLength ? m_AbsLength -> Value(energy) : DBL_MAX;
+	if      ( m_GroupVel ) m_InvVel[i] = 1. / m_GroupVel -> Value(energy);
+	else if ( m_RIndex   ) m_InvVel[i] = m_RIndex -> Value(energy) / c_light;
+	else                   m_InvVel[i] = 1. / c_light;
+	m_Weight[i] = track -> GetWeight();
+
+	if ( ++m_N == s_BatchSize ) Trace();
+}
+
+void BoxTra::Flush()
+{
+	if ( m_N > 0 ) Trace();
+}
+
+void BoxTra::Clear()
+{
+	m_N = 0;
+}
+
+//////////////////////////////////////////////////
+//   Trace the batch
+//////////////////////////////////////////////////
+void BoxTra::Trace()
+{
+	auto start = std::chrono::steady_clock::now();
+	std::size_t n = m_N;
+	m_NPhotons += n;
+
+	G4double* x[3] = {m_Pos[0].data(), m_Pos[1].data(), m_Pos[2].data()};
+	G4double* d[3] = {m_Dir[0].data(), m_Dir[1].data(), m_Dir[2].data()};
+	G4double* step = m_Step.data();
+	G4int* face = m_Face.data();
+	const G4double hx = m_Half[0], hy = m_Half[1], hz = m_Half[2];
+	CLHEP::HepRandomEngine* engine = G4Random::getTheEngine();
+
+	// Path before absorption, exponential with the absorption length
+	engine -> flatArray(n, m_Rand.data());
+	for ( std::size_t i = 0; i < n; i++ ) m_AbsLeft[i] *= -std::log(1. - m_Rand[i]);
+
+	for ( G4int round = 0; n > 0 && round < s_MaxRounds; round++ )
+	{
+		// Next face: the nearest of the three planes ahead. No branch but
+		// selects, so the compiler can vectorize it.
+		for ( std::size_t i = 0; i < n; i++ )
+		{
+			G4double tx = d[0][i] != 0. ? ((d[0][i] > 0. ? hx : -hx) - x[0][i]) / d[0][i] : DBL_MAX;
+			G4double ty = d[1][i] != 0. ? ((d[1][i] > 0. ? hy : -hy) - x[1][i]) / d[1][i] : DBL_MAX;
+			G4double tz = d[2][i] != 0. ? ((d[2][i] > 0. ? hz : -hz) - x[2][i]) / d[2][i] : DBL_MAX;
+			G4double t = std::min(tx, std::min(ty, tz));
+			step[i] = std::max(t, 0.);
+			face[i] = tz <= t ? 2 : ( ty <= t ? 1 : 0 );
+		}
+
+		// Four numbers per photon for the side face
+		engine -> flatArray(4 * n, m_Rand.data());
+
+		// Move, then absorption, arrival or side face. Photons still going
+		// are packed to the front of the arrays.
+		std::size_t alive = 0;
+		for ( std::size_t i = 0; i < n; i++ )
+		{
+			G4double t = step[i];
+			if ( m_AbsLeft[i] < t ) continue;
+			G4double path = m_Path[i] + t;
+			G4ThreeVector pos(x[0][i] + d[0][i] * t, x[1][i] + d[1][i] * t, x[2][i] + d[2][i] * t);
+			G4ThreeVector dir(d[0][i], d[1][i], d[2][i]);
+
+			G4int axis = face[i];
+			if ( axis == 2 )
+			{
+				m_EA -> AddDetected(dir.z() > 0. ? +1 : -1, m_Time[i] + path * m_InvVel[i], m_Weight[i]);
+				continue;
+			}
+
+			m_NHits++;
+			G4double cosOut, phi;
+			if ( m_ST -> Sample(std::abs(dir[axis]), &m_Rand[4 * i], cosOut, phi) != SurTab::kReflected ) continue;
+			G4ThreeVector normal, e1, e2;
+			SurTab::Frame(dir, axis, normal, e1, e2);
+			G4double sinOut = std::sqrt(std::max(1. - cosOut * cosOut, 0.));
+			dir = -cosOut * normal + sinOut * (std::cos(phi) * e1 + std::sin(phi) * e2);
+			pos[axis] = normal[axis] * m_Half[axis];
+
+			for ( G4int k = 0; k < 3; k++ )
+			{
+				x[k][alive] = pos[k];
+				d[k][alive] = dir[k];
+			}
+			m_Time[alive] = m_Time[i];
+			m_Path[alive] = path;
+			m_AbsLeft[alive] = m_AbsLeft[i] - t;
+			m_InvVel[alive] = m_InvVel[i];
+			m_Weight[alive] = m_Weight[i];
+			alive++;
+		}
+		n = alive;
+	}
+
+	m_N = 0;
+	m_Wall += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+}
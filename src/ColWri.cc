@@ -0,0 +1,236 @@
+////////////////////////////////////////////////////////////////////////////////
+//   ColWri.cc
+//
+//   Definitions of ColWri class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "ColWri.hh"
+#include "AsyWri.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+ColWri::ColWri(): m_Pending(0)
+{
+	m_File = 0;
+	m_Bat = 0;
+	m_Async = false;
+}
+
+ColWri::~ColWri()
+{
+	Close();
+}
+
+//////////////////////////////////////////////////
+//   Batch
+//////////////////////////////////////////////////
+void ColBat::Shape(const std::vector<char>& types)
+{
+	iBuf.resize(types.size());
+	dBuf.resize(types.size());
+	for ( std::size_t col = 0; col < types.size(); col++ )
+	{
+		iBuf[col].resize(types[col] == 'I' ? ColFmt::BlockRows : 0);
+		dBuf[col].resize(types[col] == 'I' ? 0 : ColFmt::BlockRows);
+	}
+	nRows = 0;
+}
+
+//////////////////////////////////////////////////
+//   Open
+//////////////////////////////////////////////////
+G4bool ColWri::Open(const G4String& fileName,
+                    const std::vector<std::pair<G4String, char>>& columns,
+                    const std::vector<std::pair<G4String, G4String>>& meta)
+{
+	Close();
+
+	m_File = std::fopen(fileName.c_str(), "wb");
+	if ( !m_File ) return false;
+	m_FileBuf.resize(1 << 20);
+	std::setvbuf(m_File, m_FileBuf.data(), _IOFBF, m_FileBuf.size());
+
+	// Row buffers
+	const std::size_t nCols = columns.size();
+	m_Types.clear();
+	for ( const auto& col: columns ) m_Types.push_back(col.second);
+	m_IRow.assign(nCols, 0);
+	m_DRow.assign(nCols, 0.);
+
+	// First batch is our own. Later ones come from the spares of AsyWri.
+	m_Async = AsyWri::IsEnabled();
+	m_Bat = new ColBat();
+	m_Bat -> Shape(m_Types);
+
+	// Header
+	std::vector<char> header;
+	auto put = [&header](const void* data, std::size_t size)
+	{
+		header.insert(header.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+	};
+
+	std::uint32_t nColumns = nCols;
+	put(&nColumns, sizeof(nColumns));
+	for ( const auto& col: columns )
+	{
+		std::uint8_t type = col.second;
+		std::uint8_t nameLength = std::min<std::size_t>(col.first.size(), 255);
+		put(&type, 1);
+		put(&nameLength, 1);
+		put(col.first.data(), nameLength);
+	}
+
+	std::uint32_t nMeta = meta.size();
+	put(&nMeta, sizeof(nMeta));
+	for ( const auto& kv: meta )
+	{
+		std::uint16_t keyLength = std::min<std::size_t>(kv.first.size(), 65535);
+		std::uint16_t valueLength = std::min<std::size_t>(kv.second.size(), 65535);
+		put(&keyLength, sizeof(keyLength));
+		put(kv.first.data(), keyLength);
+		put(&valueLength, sizeof(valueLength));
+		put(kv.second.data(), valueLength);
+	}
+
+	// First block at a multiple of 8
+	const std::size_t preamble = sizeof(ColFmt::Magic) + sizeof(std::uint32_t);
+	header.resize(ColFmt::Pad8(preamble + header.size()) - preamble, 0);
+
+	std::uint32_t headerSize = header.size();
+	Write(ColFmt::Magic, sizeof(ColFmt::Magic));
+	Write(&headerSize, sizeof(headerSize));
+	Write(header.data(), header.size());
+
+	return true;
+}
+
+//////////////////////////////////////////////////
+//   Close
+//////////////////////////////////////////////////
+void ColWri::Close()
+{
+	if ( !m_File ) return;
+
+	if ( m_Async )
+	{
+		// Last batch goes too, and then wait until the writer is done with
+		// every batch of this file.
+		if ( m_Bat -> nRows > 0 )
+		{
+			m_Pending++;
+			AsyWri::Submit(this, m_Bat, true);
+		}
+		else delete m_Bat;
+		AsyWri::Wait(m_Pending);
+	}
+	else
+	{
+		if ( m_Bat -> nRows > 0 ) WriteBlock(*m_Bat);
+		delete m_Bat;
+	}
+	m_Bat = 0;
+
+	std::fclose(m_File);
+	m_File = 0;
+}
+
+//////////////////////////////////////////////////
+//   Submit full batch
+//////////////////////////////////////////////////
+void ColWri::Submit()
+{
+	if ( !m_Async )
+	{
+		WriteBlock(*m_Bat);
+		m_Bat -> nRows = 0;
+		return;
+	}
+
+	m_Pending++;
+	AsyWri::Submit(this, m_Bat);
+	m_Bat = AsyWri::Acquire(m_Types);
+	if ( m_Bat ) return;
+
+	// Writer is stopping: the rest of the file is written here.
+	m_Async = false;
+	m_Bat = new ColBat();
+	m_Bat -> Shape(m_Types);
+}
+
+void ColWri::BatchDone()
+{
+	m_Pending--;
+}
+
+//////////////////////////////////////////////////
+//   Write block
+//////////////////////////////////////////////////
+void ColWri::WriteBlock(const ColBat& batch)
+{
+	static const unsigned char zeros[8] = {0};
+	const std::uint32_t nRows = batch.nRows;
+
+	Write(&ColFmt::BlockMagic, sizeof(ColFmt::BlockMagic));
+	Write(&nRows, sizeof(nRows));
+
+	for ( std::size_t col = 0; col < m_Types.size(); col++ )
+	{
+		std::int64_t reference = 0;
+		std::uint8_t width = 8;
+		const void* data;
+
+		if ( m_Types[col] == 'I' )
+		{
+			// Frame of reference: offsets from the minimum in the fewest bytes
+			const std::vector<std::int64_t>& values = batch.iBuf[col];
+			auto minMax = std::minmax_element(values.begin(), values.begin() + nRows);
+			reference = *minMax.first;
+			std::uint64_t range = static_cast<std::uint64_t>(*minMax.second - reference);
+			if      ( range == 0          ) width = 0;
+			else if ( range <= 0xFF       ) width = 1;
+			else if ( range <= 0xFFFF     ) width = 2;
+			else if ( range <= 0xFFFFFFFF ) width = 4;
+
+			m_Packed.resize(static_cast<std::size_t>(nRows) * width);
+			for ( std::uint32_t row = 0; row < nRows && width > 0; row++ )
+			{
+				std::uint64_t offset = static_cast<std::uint64_t>(values[row] - reference);
+				unsigned char* dst = &m_Packed[static_cast<std::size_t>(row) * width];
+				if      ( width == 1 ) { std::uint8_t  v = offset; std::memcpy(dst, &v, 1); }
+				else if ( width == 2 ) { std::uint16_t v = offset; std::memcpy(dst, &v, 2); }
+				else if ( width == 4 ) { std::uint32_t v = offset; std::memcpy(dst, &v, 4); }
+				else                   { std::memcpy(dst, &offset, 8); }
+			}
+			data = m_Packed.data();
+		}
+		else data = batch.dBuf[col].data();
+
+		unsigned char columnHeader[16] = {0};
+		std::memcpy(columnHeader, &reference, sizeof(reference));
+		columnHeader[8] = width;
+		Write(columnHeader, sizeof(columnHeader));
+
+		std::size_t size = static_cast<std::size_t>(nRows) * width;
+		Write(data, size);
+		Write(zeros, ColFmt::Pad8(size) - size);
+	}
+
+	// A block on disk is a block saved, whatever happens next.
+	if ( m_Async ) std::fflush(m_File);
+}
+
+void ColWri::Write(const void* data, std::size_t size)
+{
+	if ( size > 0 && std::fwrite(data, 1, size, m_File) != size )
+	{
+		G4ExceptionDescription ed;
+		ed << "Write to columnar output failed. The file is truncated at the last complete block.";
+		G4Exception("mCP::ColWri", "mCP009", FatalException, ed);
+	}
+}
@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////////////////////////
+//   CosGen.cc
+//
+//   Definitions of CosGen class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "G4ParticleGun.hh"
+#include "G4ParticleTable.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Box.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include "CosGen.hh"
+#include "CosMes.hh"
+#include "RunAct.hh"
+
+G4String CosGen::s_Spectrum = "";
+const G4double CosGen::s_GaisserMin = 100. * GeV;
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+CosGen::CosGen()
+{
+	// Below 70 degrees, where the Earth is still flat. 'gaisser' starts
+	// where it is valid.
+	m_EMin = s_Spectrum == "gaisser" ? s_GaisserMin : 1. * GeV;
+	m_EMax = 1. * TeV;
+	m_CosZMin = 0.34;
+	m_Ratio = 1.27;
+	m_PlaneX = m_PlaneZ = 0.;
+	m_PlaneY = 0.;
+	m_Dirty = true;
+	m_Integral = 0.;
+
+	m_LabPV = m_SciPV = 0;
+
+	G4ParticleTable* PT = G4ParticleTable::GetParticleTable();
+	m_MuP = PT -> FindParticle("mu+");
+	m_MuM = PT -> FindParticle("mu-");
+
+	m_LastE = m_LastCosZ = 0.;
+	m_LastTries = 0;
+
+	m_CM = new CosMes(this);
+
+	// Tables now, so that the first event costs as much as the others
+	Prepare();
+}
+
+CosGen::~CosGen()
+{
+	delete m_CM;
+}
+
+//////////////////////////////////////////////////
+//   Process-wide settings
+//////////////////////////////////////////////////
+void CosGen::Configure(const G4String& spectrum)
+{
+	s_Spectrum = spectrum;
+}
+
+G4bool CosGen::IsEnabled()
+{
+	return s_Spectrum != "";
+}
+
+const G4String& CosGen::GetSpectrum()
+{
+	return s_Spectrum;
+}
+
+void CosGen::AddColumns()
+{
+	// EveAct relies on this order.
+	RunAct::AddColumn("muE"    , 'D'); // GeV, total energy
+	RunAct::AddColumn("muCosZ" , 'D');
+	RunAct::AddColumn("muTries", 'I');
+}
+
+//////////////////////////////////////////////////
+//   Gaisser parametrization, /cm2/s/sr/GeV
+//////////////////////////////////////////////////
+G4double CosGen::Gaisser(G4double energy, G4double cosZ)
+{
+	// Only right above 100 GeV / cos(zenith), and far too high below
+	if ( energy * cosZ < s_GaisserMin ) return 0.;
+	G4double E = energy / GeV;
+	G4double pion = 1. / (1. + 1.1 * E * cosZ / 115.);
+	G4double kaon = 0.054 / (1. + 1.1 * E * cosZ / 850.);
+	return 0.14 * std::pow(E, -2.7) * (pion + kaon);
+}
+
+//////////////////////////////////////////////////
+//   Reyna parametrization, /cm2/s/sr/GeV
+//////////////////////////////////////////////////
+G4double CosGen::Reyna(G4double energy, G4double cosZ)
+{
+	// Vertical momentum spectrum at p cos(zenith), and dp/dE = E/p
+	G4double mass = 105.658 * MeV;
+	if ( energy <= mass || cosZ <= 0. ) return 0.;
+	G4double p = std::sqrt(energy * energy - mass * mass);
+	G4double x = p * cosZ / GeV;
+	G4double l = std::log10(x);
+	G4double power = 0.2455 + 1.288 * l - 0.2555 * l * l + 0.0209 * l * l * l;
+	return cosZ * cosZ * cosZ * 0.00253 * std::pow(x, -power) * energy / p;
+}
+
+//////////////////////////////////////////////////
+//   Table of user
+//////////////////////////////////////////////////
+void CosGen::ReadTable()
+{
+	std::ifstream file(s_Spectrum);
+	if ( !file.is_open() )
+	{
+		G4ExceptionDescription ed;
+		ed << "Cannot open cosmic muon table " << s_Spectrum << ".";
+		G4Exception("mCP::CosGen", "mCP012", FatalException, ed);
+		return;
+	}
+
+	std::map<std::pair<G4double, G4double>, G4double> points;
+	std::string line;
+	while ( std::getline(file, line) )
+	{
+		std::size_t hash = line.find('#');
+		if ( hash != std::string::npos ) line.erase(hash);
+		std::istringstream iss(line);
+		G4double E, cosZ, I;
+		if ( !(iss >> E >> cosZ >> I) ) continue;
+		points[std::make_pair(E * GeV, cosZ)] = I;
+		m_E.push_back(E * GeV);
+		m_CosZ.push_back(cosZ);
+	}
+
+	// Unique nodes, and every pair of them
+	std::sort(m_E.begin(), m_E.end());
+	m_E.erase(std::unique(m_E.begin(), m_E.end()), m_E.end());
+	std::sort(m_CosZ.begin(), m_CosZ.end());
+	m_CosZ.erase(std::unique(m_CosZ.begin(), m_CosZ.end()), m_CosZ.end());
+	G4bool ok = m_E.size() >= 2 && m_CosZ.size() >= 2 && points.size() == m_E.size() * m_CosZ.size()
+	         && m_CosZ.front() >= 0. && m_CosZ.back() <= 1.;
+	if ( !ok )
+	{
+		G4ExceptionDescription ed;
+		ed << s_Spectrum << ": needs 'energy/GeV cos(zenith) intensity' on a full grid of at least 2 x 2 nodes,"
+		   << " with cos(zenith) in [0, 1].";
+		G4Exception("mCP::CosGen", "mCP012", FatalException, ed);
+		return;
+	}
+	for ( G4double E: m_E )
+		for ( G4double cosZ: m_CosZ ) m_I.push_back(points[std::make_pair(E, cosZ)]);
+}
+
+//////////////////////////////////////////////////
+//   Cells and alias table
+//////////////////////////////////////////////////
+void CosGen::Prepare()
+{
+	if ( !m_Dirty ) return;
+	m_Dirty = false;
+
+	// Nodes and intensity on them
+	m_E.clear();
+	m_CosZ.clear();
+	m_I.clear();
+	if ( s_Spectrum == "gaisser" || s_Spectrum == "reyna" )
+	{
+		const G4int nE = 120, nCosZ = 50;
+		G4double eMin = std::max(m_EMin, 1.e-3 * GeV);
+		if ( s_Spectrum == "gaisser" && eMin < s_GaisserMin )
+		{
+			G4ExceptionDescription ed;
+			ed << "'gaisser' is only valid above " << s_GaisserMin / GeV << " GeV / cos(zenith). Lowest energy raised from "
+			   << eMin / GeV << " GeV, and no muon below that is made. Use 'reyna' for lower energies.";
+			G4Exception("mCP::CosGen", "mCP012", JustWarning, ed);
+			eMin = s_GaisserMin;
+		}
+		G4double eMax = std::max(m_EMax, eMin * 1.001);
+		for ( G4int i = 0; i <= nE; i++ ) m_E.push_back(eMin * std::pow(eMax / eMin, G4double(i) / nE));
+		for ( G4int j = 0; j <= nCosZ; j++ ) m_CosZ.push_back(m_CosZMin + (1. - m_CosZMin) * j / nCosZ);
+		for ( G4double E: m_E )
+			for ( G4double cosZ: m_CosZ ) m_I.push_back(s_Spectrum == "gaisser" ? Gaisser(E, cosZ) : Reyna(E, cosZ));
+	}
+	else ReadTable();
+
+	// Weight of a cell: mean intensity x cos(zenith) x solid angle x energy
+	const std::size_t nC = m_CosZ.size();
+	const std::size_t nCells = (m_E.size() - 1) * (nC - 1);
+	std::vector<G4double> weight(nCells);
+	m_Integral = 0.;
+	for ( std::size_t i = 0; i + 1 < m_E.size(); i++ )
+	{
+		for ( std::size_t j = 0; j + 1 < nC; j++ )
+		{
+			G4double I = (m_I[i * nC + j] + m_I[i * nC + j + 1] + m_I[(i + 1) * nC + j] + m_I[(i + 1) * nC + j + 1]) / 4.;
+			G4double cosZ = (m_CosZ[j] + m_CosZ[j + 1]) / 2.;
+			G4double w = std::max(0., I) * cosZ * twopi * (m_CosZ[j + 1] - m_CosZ[j]) * (m_E[i + 1] - m_E[i]) / GeV;
+			weight[i * (nC - 1) + j] = w;
+			m_Integral += w;
+		}
+	}
+	if ( m_Integral <= 0. )
+	{
+		G4Exception("mCP::CosGen", "mCP012", FatalException, "Cosmic muon spectrum is zero everywhere.");
+		return;
+	}
+
+	// Walker alias table, with Vose's construction
+	m_Prob.assign(nCells, 0.);
+	m_Alias.assign(nCells, 0);
+	std::vector<G4int> small, large;
+	for ( std::size_t k = 0; k < nCells; k++ )
+	{
+		weight[k] *= nCells / m_Integral;
+		if ( weight[k] < 1. ) small.push_back(k);
+		else                  large.push_back(k);
+	}
+	while ( !small.empty() && !large.empty() )
+	{
+		G4int s = small.back(); small.pop_back();
+		G4int l = large.back();
+		m_Prob[s] = weight[s];
+		m_Alias[s] = l;
+		weight[l] -= 1. - weight[s];
+		if ( weight[l] < 1. )
+		{
+			large.pop_back();
+			small.push_back(l);
+		}
+	}
+	for ( G4int k: large ) { m_Prob[k] = 1.; m_Alias[k] = k; }
+	for ( G4int k: small ) { m_Prob[k] = 1.; m_Alias[k] = k; }
+}
+
+//////////////////////////////////////////////////
+//   Geometry
+//////////////////////////////////////////////////
+void CosGen::FindVolumes()
+{
+	// The bar is resized in place, so these stay valid.
+	auto PVS = G4PhysicalVolumeStore::GetInstance();
+	m_LabPV = PVS -> GetVolume("LabPV", false);
+	m_SciPV = PVS -> GetVolume("SciPV", false);
+	if ( !m_LabPV || !m_SciPV )
+		G4Exception("mCP::CosGen", "mCP012", FatalException, "LabPV or SciPV not found.");
+}
+
+void CosGen::GetPlane(G4double& x, G4double& z, G4double& halfX, G4double& halfZ, G4double& y) const
+{
+	// Centered on the bar, by default 1 mm above it
+	const G4Box* lab = static_cast<const G4Box*>(m_LabPV -> GetLogicalVolume() -> GetSolid());
+	const G4Box* bar = static_cast<const G4Box*>(m_SciPV -> GetLogicalVolume() -> GetSolid());
+	const G4ThreeVector labCenter = m_LabPV -> GetTranslation();
+	const G4ThreeVector barCenter = labCenter + m_SciPV -> GetTranslation();
+	x = barCenter.x();
+	z = barCenter.z();
+	y = m_PlaneY > 0. ? m_PlaneY : barCenter.y() + bar -> GetYHalfLength() + 1. * mm;
+
+	// Big enough for every trajectory reaching the bar: the steepest one
+	// reaching the bottom edge is (y - bottom) x tan(zenith) off the bar.
+	// Kept in the lab.
+	G4double cosZ = m_CosZ.front();
+	G4double tanZ = cosZ > 0. ? std::sqrt(std::max(0., 1. - cosZ * cosZ)) / cosZ : DBL_MAX;
+	G4double margin = std::max(0., y - (barCenter.y() - bar -> GetYHalfLength())) * tanZ;
+	G4double labX = lab -> GetXHalfLength() - std::abs(x - labCenter.x());
+	G4double labZ = lab -> GetZHalfLength() - std::abs(z - labCenter.z());
+	halfX = m_PlaneX > 0. ? m_PlaneX : std::min(bar -> GetXHalfLength() + margin, labX);
+	halfZ = m_PlaneZ > 0. ? m_PlaneZ : std::min(bar -> GetZHalfLength() + margin, labZ);
+}
+
+G4bool CosGen::HitsBar(const G4ThreeVector& pos, const G4ThreeVector& dir) const
+{
+	// Slabs of the box, relative to its center
+	const G4Box* bar = static_cast<const G4Box*>(m_SciPV -> GetLogicalVolume() -> GetSolid());
+	G4ThreeVector p = pos - m_LabPV -> GetTranslation() - m_SciPV -> GetTranslation();
+	const G4double half[3] = { bar -> GetXHalfLength(), bar -> GetYHalfLength(), bar -> GetZHalfLength() };
+	G4double tIn = 0., tOut = DBL_MAX;
+	for ( G4int k = 0; k < 3; k++ )
+	{
+		if ( dir[k] == 0. )
+		{
+			if ( std::abs(p[k]) > half[k] ) return false;
+			continue;
+		}
+		G4double t1 = (-half[k] - p[k]) / dir[k];
+		G4double t2 = ( half[k] - p[k]) / dir[k];
+		if ( t1 > t2 ) std::swap(t1, t2);
+		tIn = std::max(tIn, t1);
+		tOut = std::min(tOut, t2);
+		if ( tIn > tOut ) return false;
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////
+//   Shoot
+//////////////////////////////////////////////////
+void CosGen::Shoot(G4ParticleGun* PG)
+{
+	Prepare();
+	if ( !m_SciPV ) FindVolumes();
+	G4double x0, z0, halfX, halfZ, y;
+	GetPlane(x0, z0, halfX, halfZ, y);
+
+	const std::size_t nC = m_CosZ.size() - 1;
+	const std::size_t nCells = m_Prob.size();
+	const G4int maxTries = 10000000;
+	G4double r[7];
+	G4ThreeVector pos, dir;
+	G4double E = 0., cosZ = 0.;
+	G4int nTries = 0;
+	do
+	{
+		if ( ++nTries > maxTries )
+		{
+			G4ExceptionDescription ed;
+			ed << "No cosmic muon hit the bar in " << maxTries << " tries. Check /mCP/cosmic/ plane settings.";
+			G4Exception("mCP::CosGen", "mCP012", FatalException, ed);
+			return;
+		}
+		G4Random::getTheEngine() -> flatArray(7, r);
+
+		// Cell from the alias table, and a point in it
+		G4double u = r[0] * nCells;
+		std::size_t k = std::min<std::size_t>(u, nCells - 1);
+		if ( u - k >= m_Prob[k] ) k = m_Alias[k];
+		std::size_t i = k / nC, j = k % nC;
+		G4double eLo = m_E[i], eHi = m_E[i + 1];
+		E = eLo > 0. ? eLo * std::pow(eHi / eLo, r[1]) : eLo + (eHi - eLo) * r[1];
+		cosZ = m_CosZ[j] + (m_CosZ[j + 1] - m_CosZ[j]) * r[2];
+
+		// Direction, downwards, and a point on the plane
+		G4double sinZ = std::sqrt(std::max(0., 1. - cosZ * cosZ));
+		G4double phi = twopi * r[3];
+		dir.set(sinZ * std::cos(phi), -cosZ, sinZ * std::sin(phi));
+		pos.set(x0 + (2. * r[4] - 1.) * halfX, y, z0 + (2. * r[5] - 1.) * halfZ);
+	}
+	while ( !HitsBar(pos, dir) );
+
+	// mu+ : mu- = ratio : 1
+	G4ParticleDefinition* muon = r[6] < m_Ratio / (1. + m_Ratio) ? m_MuP : m_MuM;
+	PG -> SetParticleDefinition(muon);
+	PG -> SetParticleEnergy(std::max(0., E - muon -> GetPDGMass()));
+	PG -> SetParticlePosition(pos);
+	PG -> SetParticleMomentumDirection(dir);
+
+	m_LastE = E;
+	m_LastCosZ = cosZ;
+	m_LastTries = nTries;
+}
+
+//////////////////////////////////////////////////
+//   Print
+//////////////////////////////////////////////////
+void CosGen::Print()
+{
+	Prepare();
+	if ( !m_SciPV ) FindVolumes();
+	G4double x0, z0, halfX, halfZ, y;
+	GetPlane(x0, z0, halfX, halfZ, y);
+	G4double area = 4. * halfX * halfZ;
+
+	G4cout << "CosGen settings:" << G4endl;
+	G4cout << "  Spectrum : " << s_Spectrum << ", " << m_E.front() / GeV << " - " << m_E.back() / GeV << " GeV, cos(zenith) "
+	       << m_CosZ.front() << " - " << m_CosZ.back() << ", " << m_Prob.size() << " cells" << G4endl;
+	G4cout << "  Charge   : mu+/mu- = " << m_Ratio << G4endl;
+	G4cout << "  Plane    : " << 2. * halfX / m << " x " << 2. * halfZ / m << " m at (" << x0 / mm << ", " << y / mm << ", " << z0 / mm << ") mm" << G4endl;
+	G4cout << "  Intensity: " << m_Integral << " /cm2/s, plane rate " << m_Integral * area / cm2 << " Hz" << G4endl;
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+//   CosMes.cc
+//
+//   Definitions of CosMes class's member functions. Macro commands for the
+// cosmic muon generator live under /mCP/cosmic/.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include "CosMes.hh"
+#include "CosGen.hh"
+
+namespace
+{
+	G4UIcmdWithADoubleAndUnit* MakeUnitCmd(const char* path, const char* guidance, const char* category, const char* unit, CosMes* CM)
+	{
+		G4UIcmdWithADoubleAndUnit* cmd = new G4UIcmdWithADoubleAndUnit(path, CM);
+		cmd -> SetGuidance(guidance);
+		cmd -> SetParameterName("value", false);
+		cmd -> SetRange("value >= 0.");
+		cmd -> SetUnitCategory(category);
+		cmd -> SetDefaultUnit(unit);
+		cmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+		return cmd;
+	}
+
+	G4UIcmdWithADouble* MakeCmd(const char* path, const char* guidance, const char* range, CosMes* CM)
+	{
+		G4UIcmdWithADouble* cmd = new G4UIcmdWithADouble(path, CM);
+		cmd -> SetGuidance(guidance);
+		cmd -> SetParameterName("value", false);
+		cmd -> SetRange(range);
+		cmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+		return cmd;
+	}
+}
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+CosMes::CosMes(CosGen* CG): G4UImessenger(), m_CG(CG)
+{
+	m_Dir = new G4UIdirectory("/mCP/");
+	m_Dir -> SetGuidance("mCP specific controls.");
+
+	m_CosDir = new G4UIdirectory("/mCP/cosmic/");
+	m_CosDir -> SetGuidance("Cosmic muon generator controls ('--cosmic').");
+	m_CosDir -> SetGuidance("Energy range and zenith cut do not apply to tables.");
+
+	m_EMinCmd    = MakeUnitCmd("/mCP/cosmic/energyMin", "Lowest total energy of muons.", "Energy", "GeV", this);
+	m_EMaxCmd    = MakeUnitCmd("/mCP/cosmic/energyMax", "Highest total energy of muons.", "Energy", "GeV", this);
+	m_CosZMinCmd = MakeCmd("/mCP/cosmic/cosZenithMin", "Lowest cos(zenith) of muons.", "value >= 0. && value < 1.", this);
+	m_RatioCmd   = MakeCmd("/mCP/cosmic/chargeRatio", "Ratio of mu+ to mu-.", "value >= 0.", this);
+	m_PlaneXCmd  = MakeUnitCmd("/mCP/cosmic/planeHalfX", "Half length of the plane in x. 0 covers every muon that can reach the bar.", "Length", "mm", this);
+	m_PlaneZCmd  = MakeUnitCmd("/mCP/cosmic/planeHalfZ", "Half length of the plane in z. 0 covers every muon that can reach the bar.", "Length", "mm", this);
+	m_PlaneYCmd  = MakeUnitCmd("/mCP/cosmic/planeY", "Height of the plane. 0 is just above the bar.", "Length", "mm", this);
+
+	m_PrintCmd = new G4UIcmdWithoutParameter("/mCP/cosmic/print", this);
+	m_PrintCmd -> SetGuidance("Print current settings and the rate of muons through the plane.");
+	m_PrintCmd -> AvailableForStates(G4State_Idle);
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+CosMes::~CosMes()
+{
+	delete m_PrintCmd;
+	delete m_PlaneYCmd;
+	delete m_PlaneZCmd;
+	delete m_PlaneXCmd;
+	delete m_RatioCmd;
+	delete m_CosZMinCmd;
+	delete m_EMaxCmd;
+	delete m_EMinCmd;
+	delete m_CosDir;
+	delete m_Dir;
+}
+
+//////////////////////////////////////////////////
+//   Set new value
+//////////////////////////////////////////////////
+void CosMes::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+	if      ( command == m_EMinCmd    ) m_CG -> SetEnergyMin(m_EMinCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_EMaxCmd    ) m_CG -> SetEnergyMax(m_EMaxCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_CosZMinCmd ) m_CG -> SetCosZMin(m_CosZMinCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_RatioCmd   ) m_CG -> SetChargeRatio(m_RatioCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_PlaneXCmd  ) m_CG -> SetPlaneHalfX(m_PlaneXCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_PlaneZCmd  ) m_CG -> SetPlaneHalfZ(m_PlaneZCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_PlaneYCmd  ) m_CG -> SetPlaneY(m_PlaneYCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_PrintCmd   ) m_CG -> Print();
+}
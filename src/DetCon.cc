@@ -16,20 +16,41 @@
 #include "G4UIcommand.hh"
 #include "G4VisAttributes.hh"
 #include "G4Colour.hh"
+#include "G4Region.hh"
+#include "G4UImanager.hh"
+#include "G4SDManager.hh"
 
 #include "DetCon.hh"
+#include "OptMap.hh"
+#include "OptMod.hh"
+#include "DetMes.hh"
+#include "MatDat.hh"
+#include "SenSD.hh"
+
 
 //////////////////////////////////////////////////
 //   Constructor and destructor
 //////////////////////////////////////////////////
 DetCon::DetCon()
 {
+	m_WorldSolid = 0;
+	m_LabSolid = 0;
+	m_SciSolid = 0;
+	m_SenSolid = 0;
+	m_SenLV = 0;
+	m_SenPV[0] = m_SenPV[1] = 0;
+	m_SciOpS = 0;
+	m_MD = 0;
+
 	ConstructMaterials();
 	DefineDimensions();
+
+	m_DM = new DetMes(this);
 }
 
 DetCon::~DetCon()
 {
+	delete m_DM;
 	DestructMaterials();
 }
 
@@ -47,6 +68,9 @@ void DetCon::DefineDimensions()
 	m_SciX =   50. * mm; // Scintillator x dimension
 	m_SciY =   50. * mm; // Scintillator y dimension
 	m_SciZ = 1500. * mm; // Scintillator z dimension
+
+	// Photosensor window: bar cross section, this thick
+	m_SenZ =    1. * mm;
 }
 
 //////////////////////////////////////////////////
@@ -72,52 +96,143 @@ G4VPhysicalVolume* DetCon::Construct()
 	m_SciLV = new G4LogicalVolume(m_SciSolid, m_SciMat, "SciLV");
 	m_SciPV = new G4PVPlacement(0, G4ThreeVector(), "SciPV", m_SciLV, m_LabPV, false, 0);
 
+	// Photosensors
+	// Right on the end faces of the bar, without a surface in between, so
+	// photons go in by the refractive indices of both.
+	if ( SenSD::IsEnabled() )
+	{
+		m_SenSolid = new G4Box("SenSolid", m_SciX / 2., m_SciY / 2., m_SenZ / 2.);
+		m_SenLV = new G4LogicalVolume(m_SenSolid, m_SenMat, "SenLV");
+		for ( G4int i = 0; i < 2; i++ )
+		{
+			G4double z = (i == 0 ? +1. : -1.) * (m_SciZ + m_SenZ) / 2.;
+			m_SenPV[i] = new G4PVPlacement(0, G4ThreeVector(0., 0., z), "SenPV", m_SenLV, m_LabPV, false, i);
+		}
+	}
+
+	// Region of the bar, for the fast optical model
+	m_SciRegion = new G4Region("SciRegion");
+	m_SciRegion -> AddRootLogicalVolume(m_SciLV);
 
 	//------------------------------------------------
 	//   Surfaces
 	//------------------------------------------------
 	// Scintillator
-	m_SciOpS = new G4OpticalSurface("SciOpS");
-	m_SciOpS -> SetType(dielectric_LUTDAVIS);
-	m_SciOpS -> SetFinish(RoughTeflon_LUT); // Surface property
-	m_SciOpS -> SetModel(DAVIS);
-
+	// Optical surfaces come from the material data file, and the finish may
+	// have been changed since.
 	m_SciLBS = new G4LogicalBorderSurface("SciLBS", m_SciPV, m_LabPV, m_SciOpS);
 
 	G4OpticalSurface* opS = dynamic_cast<G4OpticalSurface*>(m_SciLBS -> GetSurface(m_SciPV, m_LabPV) -> GetSurfaceProperty());
 	if ( opS ) opS -> DumpInfo();
 
 	// Air
-	m_AirOpS = new G4OpticalSurface("AirOpS");
-	m_AirOpS -> SetType(dielectric_dielectric);
-	m_AirOpS -> SetFinish(polished);
-	m_AirOpS -> SetModel(glisur);
+	if ( m_AirOpS && m_AirOpS -> GetMaterialPropertiesTable() )
+	{
+		G4cout << "Air Surface G4MaterialPropertiesTable:" << G4endl;
+		m_AirOpS -> GetMaterialPropertiesTable() -> DumpTable();
+	}
 
-	// Generate & Add Material Properties Table attached to the optical surfaces
-	std::vector<G4double> ephoton = { 2.034 * eV, 4.136 * eV };
 
-	// OpticalAirSurface
-	std::vector<G4double> reflectivity = { 0.3, 0.5 };
-	std::vector<G4double> efficiency   = { 0.8, 1.0 };
+	return m_LabPV;
+}
 
-	m_AirST = new G4MaterialPropertiesTable();
+//////////////////////////////////////////////////
+//   Construct fast simulation models
+//////////////////////////////////////////////////
+void DetCon::ConstructSDandField()
+{
+	// Every thread has its own model. It is owned by the region's fast
+	// simulation manager.
+	if ( OptMap::GetMode() == OptMap::kFast ) new OptMod("OptMod", m_SciRegion);
 
-	m_AirST -> AddProperty("REFLECTIVITY", ephoton, reflectivity);
-	m_AirST -> AddProperty("EFFICIENCY", ephoton, efficiency);
+	// Photosensors: one detector per thread
+	if ( m_SenLV )
+	{
+		SenSD* SD = new SenSD("SenSD", "SenHC");
+		G4SDManager::GetSDMpointer() -> AddNewDetector(SD);
+		SetSensitiveDetector(m_SenLV, SD);
+	}
+}
 
-	G4cout << "Air Surface G4MaterialPropertiesTable:" << G4endl;
-	m_AirST -> DumpTable();
+//////////////////////////////////////////////////
+//   Change geometry between runs
+//////////////////////////////////////////////////
+G4ThreeVector DetCon::GetSciSize() const
+{
+	return G4ThreeVector(m_SciX, m_SciY, m_SciZ);
+}
 
-	m_AirOpS -> SetMaterialPropertiesTable(m_AirST);
+G4ThreeVector DetCon::GetLabSize() const
+{
+	return G4ThreeVector(m_LabX, m_LabY, m_LabZ);
+}
 
+void DetCon::SetSizes(const G4ThreeVector& sci, const G4ThreeVector& lab)
+{
+	G4double senZ = SenSD::IsEnabled() ? 2. * m_SenZ : 0.;
+	if ( sci.x() >= lab.x() || sci.y() >= lab.y() || sci.z() + senZ >= lab.z() )
+	{
+		G4ExceptionDescription ed;
+		ed << "Bar of " << sci / mm << " mm does not fit in lab of " << lab / mm << " mm. Geometry is not changed.";
+		G4Exception("mCP::DetCon", "mCP001", JustWarning, ed);
+		return;
+	}
 
-	return m_LabPV;
+	m_SciX = sci.x(); m_SciY = sci.y(); m_SciZ = sci.z();
+	m_LabX = lab.x(); m_LabY = lab.y(); m_LabZ = lab.z();
+
+	// Not built yet: Construct() takes them as they are.
+	if ( !m_SciSolid ) return;
+
+	// Same volumes and materials, so cuts and physics tables stay valid. Only
+	// voxels of the mother volumes have to be made again.
+	m_WorldSolid -> SetXHalfLength(m_LabX / 2.);
+	m_WorldSolid -> SetYHalfLength(m_LabY / 2.);
+	m_WorldSolid -> SetZHalfLength(m_LabZ / 2.);
+	m_LabSolid -> SetXHalfLength(m_LabX / 2.);
+	m_LabSolid -> SetYHalfLength(m_LabY / 2.);
+	m_LabSolid -> SetZHalfLength(m_LabZ / 2.);
+	m_SciSolid -> SetXHalfLength(m_SciX / 2.);
+	m_SciSolid -> SetYHalfLength(m_SciY / 2.);
+	m_SciSolid -> SetZHalfLength(m_SciZ / 2.);
+	if ( m_SenSolid )
+	{
+		m_SenSolid -> SetXHalfLength(m_SciX / 2.);
+		m_SenSolid -> SetYHalfLength(m_SciY / 2.);
+		for ( G4int i = 0; i < 2; i++ )
+			m_SenPV[i] -> SetTranslation(G4ThreeVector(0., 0., (i == 0 ? +1. : -1.) * (m_SciZ + m_SenZ) / 2.));
+	}
+	G4UImanager::GetUIpointer() -> ApplyCommand("/run/geometryModified");
 }
 
-void DetCon::ConstructMaterials()
+const G4String& DetCon::GetSurfaceFinish() const
 {
-	const G4double labTemp = 300.0 * kelvin;
+	return m_SciFinish;
+}
 
+void DetCon::SetSurfaceFinish(const G4String& finish)
+{
+	m_SciFinish = finish;
+
+	// Look-up table of the new finish is read here.
+	G4OpticalSurfaceFinish opF;
+	if ( !MatDat::FinishFromName(m_SciFinish, opF) )
+	{
+		G4ExceptionDescription ed;
+		ed << "Unknown surface finish '" << finish << "'.";
+		G4Exception("mCP::DetCon", "mCP001", FatalException, ed);
+	}
+	m_SciOpS -> SetFinish(opF);
+}
+
+void DetCon::Print() const
+{
+	G4cout << "mCP: bar " << m_SciX / mm << " x " << m_SciY / mm << " x " << m_SciZ / mm << " mm, "
+	       << m_SciFinish << ", in lab " << m_LabX / mm << " x " << m_LabY / mm << " x " << m_LabZ / mm << " mm" << G4endl;
+}
+
+void DetCon::ConstructMaterials()
+{
 	// Elements to be used to construct materials
 	m_ElH  = new G4Element("Hydrogen",  "H",  1,   1.00794 * g/mole);
 	m_ElC  = new G4Element(  "Carbon",  "C",  6,  12.0107  * g/mole);
@@ -125,78 +240,25 @@ void DetCon::ConstructMaterials()
 	m_ElO  = new G4Element(  "Oxygen",  "O",  8,  15.9994  * g/mole);
 	m_ElAr = new G4Element(   "Argon", "Ar", 18,  39.948   * g/mole);
 
-	// Vacuum material
-	m_VacMat = new G4Material("Vacuum", 0.1225e-5*g/cm3, 3, kStateGas, labTemp);
-	m_VacMat -> AddElement(m_ElN, 75.47/99.95);
-	m_VacMat -> AddElement(m_ElO, 23.20/99.95);
-	m_VacMat -> AddElement(m_ElAr, 1.28/99.95);
-
-	// Air material
-	m_AirMat = new G4Material("Air", 1.225e-3*g/cm3, 3, kStateGas, labTemp);
-	m_AirMat -> AddElement(m_ElN, 75.47/99.95);
-	m_AirMat -> AddElement(m_ElO, 23.20/99.95);
-	m_AirMat -> AddElement(m_ElAr, 1.28/99.95);
-
-	// Scintillator material
-	// (Basen od EJ-200 datasheet: https://eljentechnology.com/products/plastic-scintillators/ej-200-ej-204-ej-208-ej-212)
-	m_SciMat = new G4Material("scint", 1.023*g/cm3, 2, kStateSolid, labTemp);
-	m_SciMat -> AddElement(m_ElH, 5.17 / 9.86);
-	m_SciMat -> AddElement(m_ElC, 4.69 / 9.86);
-
-	//------------------------------------------------
-	// Generate & add material properties table
-	//------------------------------------------------
-	std::vector<G4double> photonEnergy = {2.480 * eV, 2.485 * eV, 2.490 * eV, 2.495 * eV, 2.500 * eV, 2.505 * eV, 2.510 * eV, 2.515 * eV, 2.520 * eV, 2.525 * eV,
-	                                      2.530 * eV, 2.536 * eV, 2.541 * eV, 2.546 * eV, 2.551 * eV, 2.557 * eV, 2.562 * eV, 2.567 * eV, 2.572 * eV, 2.578 * eV,
-	                                      2.583 * eV, 2.589 * eV, 2.594 * eV, 2.599 * eV, 2.605 * eV, 2.610 * eV, 2.616 * eV, 2.621 * eV, 2.627 * eV, 2.633 * eV,
-	                                      2.638 * eV, 2.644 * eV, 2.649 * eV, 2.655 * eV, 2.661 * eV, 2.667 * eV, 2.672 * eV, 2.678 * eV, 2.684 * eV, 2.690 * eV,
-	                                      2.696 * eV, 2.701 * eV, 2.707 * eV, 2.713 * eV, 2.719 * eV, 2.725 * eV, 2.731 * eV, 2.737 * eV, 2.743 * eV, 2.749 * eV,
-	                                      2.755 * eV, 2.762 * eV, 2.768 * eV, 2.774 * eV, 2.780 * eV, 2.786 * eV, 2.793 * eV, 2.799 * eV, 2.805 * eV, 2.812 * eV,
-	                                      2.818 * eV, 2.824 * eV, 2.831 * eV, 2.837 * eV, 2.844 * eV, 2.850 * eV, 2.857 * eV, 2.864 * eV, 2.870 * eV, 2.877 * eV,
-	                                      2.884 * eV, 2.890 * eV, 2.897 * eV, 2.904 * eV, 2.911 * eV, 2.918 * eV, 2.924 * eV, 2.931 * eV, 2.938 * eV, 2.945 * eV,
-	                                      2.952 * eV, 2.959 * eV, 2.966 * eV, 2.973 * eV, 2.981 * eV, 2.988 * eV, 2.995 * eV, 3.002 * eV, 3.010 * eV, 3.017 * eV,
-	                                      3.024 * eV, 3.032 * eV, 3.039 * eV, 3.047 * eV, 3.054 * eV, 3.062 * eV, 3.069 * eV, 3.077 * eV, 3.084 * eV, 3.092 * eV,
-	                                      3.100 * eV, 3.108 * eV, 3.115 * eV, 3.123 * eV, 3.131 * eV, 3.139 * eV};
-	std::vector<G4double> rindex = {1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58, 1.58,
-	                                1.58, 1.58, 1.58, 1.58, 1.58, 1.58};
-	std::vector<G4double> absorption = {3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m,
-	                                    3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m, 3.8 * m};
-	std::vector<G4double> scintil = {0.000, 0.062, 0.066, 0.071, 0.075, 0.079, 0.084, 0.088, 0.092, 0.097,
-	                                 0.104, 0.111, 0.118, 0.125, 0.131, 0.137, 0.146, 0.155, 0.164, 0.170,
-	                                 0.176, 0.182, 0.195, 0.209, 0.221, 0.233, 0.244, 0.258, 0.271, 0.285,
-	                                 0.302, 0.320, 0.335, 0.351, 0.366, 0.382, 0.397, 0.408, 0.416, 0.426,
-	                                 0.440, 0.453, 0.462, 0.470, 0.478, 0.488, 0.499, 0.512, 0.528, 0.543,
-	                                 0.563, 0.583, 0.598, 0.612, 0.626, 0.645, 0.665, 0.685, 0.705, 0.730,
-	                                 0.758, 0.779, 0.800, 0.824, 0.846, 0.866, 0.886, 0.906, 0.926, 0.944,
-	                                 0.964, 0.988, 0.997, 1.000, 1.003, 1.001, 0.987, 0.973, 0.954, 0.916,
-	                                 0.872, 0.815, 0.763, 0.691, 0.631, 0.559, 0.494, 0.428, 0.364, 0.314,
-	                                 0.271, 0.218, 0.179, 0.147, 0.122, 0.099, 0.074, 0.049, 0.037, 0.028,
-	                                 0.019, 0.015, 0.014, 0.013, 0.011, 0.000};
-
-	m_SciMPT = new G4MaterialPropertiesTable();
-
-	m_SciMPT->AddProperty("RINDEX", photonEnergy, rindex, false, true);
+	// Materials and surfaces from data file
+	// Elements above are found there by their symbols.
+	m_MD = new MatDat();
+	m_MD -> Load(MatDat::GetFileName());
+	m_VacMat = m_MD -> GetMaterial("world");
+	m_AirMat = m_MD -> GetMaterial("lab");
+	m_SciMat = m_MD -> GetMaterial("bar");
+	m_SenMat = m_MD -> GetMaterial("sensor");
+	if ( SenSD::IsEnabled() && !m_SenMat )
+	{
+		G4ExceptionDescription ed;
+		ed << "No sensor material in " << MatDat::GetFileName() << ".";
+		G4Exception("mCP::DetCon", "mCP001", FatalException, ed);
+	}
 
 	// Check that group velocity is calculated from RINDEX
-	if ( m_SciMPT -> GetProperty("RINDEX") -> GetVectorLength() != m_SciMPT -> GetProperty("GROUPVEL") -> GetVectorLength())
+	G4MaterialPropertiesTable* sciMPT = m_SciMat -> GetMaterialPropertiesTable();
+	if ( sciMPT && sciMPT -> GetProperty("RINDEX") &&
+	     ( !sciMPT -> GetProperty("GROUPVEL") || sciMPT -> GetProperty("RINDEX") -> GetVectorLength() != sciMPT -> GetProperty("GROUPVEL") -> GetVectorLength() ) )
 	{
 		G4ExceptionDescription ed;
 		ed << "Error calculating group velocities. Incorrect number of entries "
@@ -204,47 +266,28 @@ void DetCon::ConstructMaterials()
 		G4Exception("mCP::DetCon", "mCP001", FatalException, ed);
 	}
 
-	// Adding a property from two std::vectors. Argument createNewKey is false and spline is true.
-	m_SciMPT -> AddProperty("ABSLENGTH", photonEnergy, absorption, false, true);
-
-	// Adding a property using a C-style array.
-	// Spline interpolation isn't used for scintillation.
-	// Arguments spline and createNewKey both take default value false.
-	m_SciMPT -> AddProperty("SCINTILLATIONCOMPONENT1", photonEnergy, scintil, false, true);
-	m_SciMPT -> AddConstProperty("SCINTILLATIONYIELD", 10000. / MeV);
-	m_SciMPT -> AddConstProperty("RESOLUTIONSCALE", .0);
-	m_SciMPT -> AddConstProperty("SCINTILLATIONTIMECONSTANT1", 2.1 * ns);
-	m_SciMPT -> AddConstProperty("SCINTILLATIONRISETIME1"    , 0.9 * ns);
-	m_SciMat -> SetMaterialPropertiesTable(m_SciMPT);
-
+	// Surface of the bar, and the air one
+	m_SciOpS = m_MD -> GetSurface("SciOpS");
+	m_AirOpS = m_MD -> GetSurface("AirOpS");
+	if ( !m_SciOpS )
+	{
+		G4ExceptionDescription ed;
+		ed << "No surface SciOpS in " << MatDat::GetFileName() << ".";
+		G4Exception("mCP::DetCon", "mCP001", FatalException, ed);
+	}
+	m_SciFinish = MatDat::NameOfFinish(m_SciOpS -> GetFinish());
 
-	// Air
-	std::vector<G4double> rindex2 = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
-	                                 1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
-	m_AirMPT = new G4MaterialPropertiesTable();
-	m_AirMPT -> AddProperty("RINDEX", photonEnergy, rindex2);
-	G4cout << "Air G4MaterialPropertiesTable:" << G4endl;
-	m_AirMPT -> DumpTable();
-	m_AirMat -> SetMaterialPropertiesTable(m_AirMPT);
+	if ( m_AirMat -> GetMaterialPropertiesTable() )
+	{
+		G4cout << "Air G4MaterialPropertiesTable:" << G4endl;
+		m_AirMat -> GetMaterialPropertiesTable() -> DumpTable();
+	}
 }
 
 void DetCon::DestructMaterials()
 {
-	delete m_AirMPT;
-	delete m_SciMPT;
-
-	delete m_SciMat;
-	delete m_AirMat;
-	delete m_VacMat;
+	// Materials and their tables
+	delete m_MD;
 
 	delete m_ElAr;
 	delete m_ElO;
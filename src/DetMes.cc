@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+//   DetMes.cc
+//
+//   Definitions of DetMes class's member functions. Macro commands for the
+// geometry live under /mCP/det/.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include "DetMes.hh"
+#include "DetCon.hh"
+
+namespace
+{
+	G4UIcmdWithADoubleAndUnit* MakeLengthCmd(const char* path, const char* guidance, DetMes* DM)
+	{
+		G4UIcmdWithADoubleAndUnit* cmd = new G4UIcmdWithADoubleAndUnit(path, DM);
+		cmd -> SetGuidance(guidance);
+		cmd -> SetParameterName("length", false);
+		cmd -> SetRange("length > 0.");
+		cmd -> SetUnitCategory("Length");
+		cmd -> SetDefaultUnit("mm");
+		cmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+		// Geometry lives in master. Workers only see it changed.
+		cmd -> SetToBeBroadcasted(false);
+		return cmd;
+	}
+}
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+DetMes::DetMes(DetCon* DC): G4UImessenger(), m_DC(DC)
+{
+	m_Dir = new G4UIdirectory("/mCP/");
+	m_Dir -> SetGuidance("mCP specific controls.");
+
+	m_DetDir = new G4UIdirectory("/mCP/det/");
+	m_DetDir -> SetGuidance("Geometry controls.");
+	m_DetDir -> SetGuidance("Solids are resized in place between runs. Materials and physics tables are kept,");
+	m_DetDir -> SetGuidance("and only the navigation of the changed volumes is rebuilt at the next /run/beamOn.");
+
+	m_SciXCmd = MakeLengthCmd("/mCP/det/sciX", "Full x length of the bar.", this);
+	m_SciYCmd = MakeLengthCmd("/mCP/det/sciY", "Full y length of the bar.", this);
+	m_SciZCmd = MakeLengthCmd("/mCP/det/sciZ", "Full z length of the bar, along which it is read out.", this);
+	m_LabXCmd = MakeLengthCmd("/mCP/det/labX", "Full x length of the lab.", this);
+	m_LabYCmd = MakeLengthCmd("/mCP/det/labY", "Full y length of the lab.", this);
+	m_LabZCmd = MakeLengthCmd("/mCP/det/labZ", "Full z length of the lab.", this);
+
+	m_FinishCmd = new G4UIcmdWithAString("/mCP/det/surfaceFinish", this);
+	m_FinishCmd -> SetGuidance("Finish of the bar surface, from the DAVIS look-up tables.");
+	m_FinishCmd -> SetParameterName("finish", false);
+	m_FinishCmd -> SetCandidates("Rough_LUT RoughTeflon_LUT RoughESR_LUT RoughESRGrease_LUT "
+	                             "Polished_LUT PolishedTeflon_LUT PolishedESR_LUT PolishedESRGrease_LUT Detector_LUT");
+	m_FinishCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+	m_FinishCmd -> SetToBeBroadcasted(false);
+
+	m_PrintCmd = new G4UIcmdWithoutParameter("/mCP/det/print", this);
+	m_PrintCmd -> SetGuidance("Print current dimensions and surface finish.");
+	m_PrintCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+	m_PrintCmd -> SetToBeBroadcasted(false);
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+DetMes::~DetMes()
+{
+	delete m_PrintCmd;
+	delete m_FinishCmd;
+	delete m_LabZCmd;
+	delete m_LabYCmd;
+	delete m_LabXCmd;
+	delete m_SciZCmd;
+	delete m_SciYCmd;
+	delete m_SciXCmd;
+	delete m_DetDir;
+	delete m_Dir;
+}
+
+//////////////////////////////////////////////////
+//   Set new value
+//////////////////////////////////////////////////
+void DetMes::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+	G4ThreeVector sci = m_DC -> GetSciSize();
+	G4ThreeVector lab = m_DC -> GetLabSize();
+
+	if      ( command == m_SciXCmd ) sci.setX(m_SciXCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_SciYCmd ) sci.setY(m_SciYCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_SciZCmd ) sci.setZ(m_SciZCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_LabXCmd ) lab.setX(m_LabXCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_LabYCmd ) lab.setY(m_LabYCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_LabZCmd ) lab.setZ(m_LabZCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_FinishCmd ) { m_DC -> SetSurfaceFinish(newValue); return; }
+	else if ( command == m_PrintCmd  ) { m_DC -> Print(); return; }
+
+	m_DC -> SetSizes(sci, lab);
+}
+
+//////////////////////////////////////////////////
+//   Get current value
+//////////////////////////////////////////////////
+G4String DetMes::GetCurrentValue(G4UIcommand* command)
+{
+	G4ThreeVector sci = m_DC -> GetSciSize();
+	G4ThreeVector lab = m_DC -> GetLabSize();
+
+	if ( command == m_SciXCmd ) return m_SciXCmd -> ConvertToString(sci.x(), "mm");
+	if ( command == m_SciYCmd ) return m_SciYCmd -> ConvertToString(sci.y(), "mm");
+	if ( command == m_SciZCmd ) return m_SciZCmd -> ConvertToString(sci.z(), "mm");
+	if ( command == m_LabXCmd ) return m_LabXCmd -> ConvertToString(lab.x(), "mm");
+	if ( command == m_LabYCmd ) return m_LabYCmd -> ConvertToString(lab.y(), "mm");
+	if ( command == m_LabZCmd ) return m_LabZCmd -> ConvertToString(lab.z(), "mm");
+	if ( command == m_FinishCmd ) return m_DC -> GetSurfaceFinish();
+
+	return "";
+}
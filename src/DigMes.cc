@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//   DigMes.cc
+//
+//   Definitions of DigMes class's member functions. Macro commands for the
+// waveform digitizer live under /mCP/digi/.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include "DigMes.hh"
+#include "WavDig.hh"
+
+namespace
+{
+	G4UIcmdWithADoubleAndUnit* MakeTimeCmd(const char* path, const char* guidance, G4bool positive, DigMes* DM)
+	{
+		G4UIcmdWithADoubleAndUnit* cmd = new G4UIcmdWithADoubleAndUnit(path, DM);
+		cmd -> SetGuidance(guidance);
+		cmd -> SetParameterName("time", false);
+		if ( positive ) cmd -> SetRange("time > 0.");
+		cmd -> SetUnitCategory("Time");
+		cmd -> SetDefaultUnit("ns");
+		cmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+		return cmd;
+	}
+
+	G4UIcmdWithADouble* MakeCmd(const char* path, const char* guidance, const char* range, DigMes* DM)
+	{
+		G4UIcmdWithADouble* cmd = new G4UIcmdWithADouble(path, DM);
+		cmd -> SetGuidance(guidance);
+		cmd -> SetParameterName("value", false);
+		cmd -> SetRange(range);
+		cmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+		return cmd;
+	}
+}
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+DigMes::DigMes(WavDig* WD): G4UImessenger(), m_WD(WD)
+{
+	m_Dir = new G4UIdirectory("/mCP/");
+	m_Dir -> SetGuidance("mCP specific controls.");
+
+	m_DigDir = new G4UIdirectory("/mCP/digi/");
+	m_DigDir -> SetGuidance("Waveform digitizer controls ('--digitize').");
+	m_DigDir -> SetGuidance("Amplitudes are in mV.");
+
+	m_SamplingCmd = MakeTimeCmd("/mCP/digi/sampling", "Sampling period.", true, this);
+	m_StartCmd    = MakeTimeCmd("/mCP/digi/start", "Global time of the first sample.", false, this);
+	m_WindowCmd   = MakeTimeCmd("/mCP/digi/window", "Length of the waveform.", true, this);
+	m_RiseCmd     = MakeTimeCmd("/mCP/digi/riseTime", "Rise time constant of the single photoelectron pulse.", true, this);
+	m_FallCmd     = MakeTimeCmd("/mCP/digi/fallTime", "Fall time constant of the single photoelectron pulse.", true, this);
+	m_SPECmd   = MakeCmd("/mCP/digi/speAmplitude", "Peak of the single photoelectron pulse.", "value > 0.", this);
+	m_NoiseCmd = MakeCmd("/mCP/digi/noise", "RMS of the noise of every sample.", "value >= 0.", this);
+	m_ThrCmd   = MakeCmd("/mCP/digi/threshold", "Threshold of the leading edge time.", "value > 0.", this);
+	m_CFDCmd   = MakeCmd("/mCP/digi/cfdFraction", "Fraction of the amplitude of the CFD time.", "value > 0. && value < 1.", this);
+
+	m_PrintCmd = new G4UIcmdWithoutParameter("/mCP/digi/print", this);
+	m_PrintCmd -> SetGuidance("Print current settings.");
+	m_PrintCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+DigMes::~DigMes()
+{
+	delete m_PrintCmd;
+	delete m_CFDCmd;
+	delete m_ThrCmd;
+	delete m_NoiseCmd;
+	delete m_SPECmd;
+	delete m_FallCmd;
+	delete m_RiseCmd;
+	delete m_WindowCmd;
+	delete m_StartCmd;
+	delete m_SamplingCmd;
+	delete m_DigDir;
+	delete m_Dir;
+}
+
+//////////////////////////////////////////////////
+//   Set new value
+//////////////////////////////////////////////////
+void DigMes::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+	if      ( command == m_SamplingCmd ) m_WD -> SetSampling(m_SamplingCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_StartCmd    ) m_WD -> SetStart(m_StartCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_WindowCmd   ) m_WD -> SetWindow(m_WindowCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_RiseCmd     ) m_WD -> SetRiseTime(m_RiseCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_FallCmd     ) m_WD -> SetFallTime(m_FallCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_SPECmd      ) m_WD -> SetSPEAmplitude(m_SPECmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_NoiseCmd    ) m_WD -> SetNoise(m_NoiseCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_ThrCmd      ) m_WD -> SetThreshold(m_ThrCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_CFDCmd      ) m_WD -> SetCFDFraction(m_CFDCmd -> GetNewDoubleValue(newValue));
+	else if ( command == m_PrintCmd    ) m_WD -> Print();
+}
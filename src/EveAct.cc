@@ -8,13 +8,24 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <ctime>
+#include <cmath>
+#include <algorithm>
 
 #include "G4Event.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
-#include "G4RootAnalysisManager.hh"
+#include "G4AutoLock.hh"
 
 #include "EveAct.hh"
+#include "EveInf.hh"
+#include "RunAct.hh"
+#include "OutMan.hh"
+#include "EvePro.hh"
+#include "SenSD.hh"
+#include "WavDig.hh"
+#include "CosGen.hh"
+
+namespace { G4Mutex mergeMutex = G4MUTEX_INITIALIZER; }
 
 //////////////////////////////////////////////////
 //   Constructor
@@ -24,6 +35,44 @@ EveAct::EveAct()
 	// Initialize
 	m_NScint = 0;
 	m_NCeren = 0;
+
+	m_SubEvent = false;
+	m_SubEventWorker = false;
+
+	m_NDet[0] = m_NDet[1] = 0;
+	m_TDet[0] = m_TDet[1] = 0.;
+
+	// Detected photon columns come as a block of four, see main().
+	m_NDetCol = RunAct::GetColumnID("nDetPz");
+
+	// So do photosensor columns, see main().
+	m_NSenCol = RunAct::GetColumnID("nSenPz");
+
+	// And waveform columns, see WavDig::AddColumns().
+	m_DigCol = RunAct::GetColumnID("ampPz");
+	m_Dig = m_DigCol >= 0 ? new WavDig() : 0;
+
+	// Weighted columns of '--thin', see StaAct::EnableThinning()
+	m_ThinCol = RunAct::GetColumnID("wScint");
+
+	// Columns of '--acceptance', see AccFil::Configure()
+	m_AccCol = RunAct::GetColumnID("accKilled");
+	m_AccKilled = 0;
+	m_AccLost = 0.;
+
+	// Muon columns of '--cosmic', see CosGen::AddColumns()
+	m_CG = 0;
+	m_CosCol = RunAct::GetColumnID("muE");
+
+	// Profiling columns come as a block too, see EvePro::AddColumns().
+	m_ProCol = RunAct::GetColumnID("tWall");
+	m_Pro = m_ProCol >= 0 ? new EvePro() : 0;
+
+	// Summary mode only
+	m_HisScint = OutMan::Instance() -> GetHis(OutMan::kHisScint);
+	m_HisCeren = OutMan::Instance() -> GetHis(OutMan::kHisCeren);
+
+	ResetSummary();
 }
 
 //////////////////////////////////////////////////
@@ -31,16 +80,32 @@ EveAct::EveAct()
 //////////////////////////////////////////////////
 EveAct::~EveAct()
 {
+	delete m_Dig;
+	delete m_Pro;
 }
 
 //////////////////////////////////////////////////
 //   Begin of event action
 //////////////////////////////////////////////////
-void EveAct::BeginOfEventAction(const G4Event* /* anEvent */)
+void EveAct::BeginOfEventAction(const G4Event* anEvent)
 {
 	// Initialize
 	m_NScint = 0;
 	m_NCeren = 0;
+	m_NDet[0] = m_NDet[1] = 0;
+	m_TDet[0] = m_TDet[1] = 0.;
+	m_Times[0].clear();
+	m_Times[1].clear();
+	for ( G4int i = 0; i < kNWeighted; i++ ) m_WSum[i] = m_WVar[i] = 0.;
+	m_AccKilled = 0;
+	m_AccLost = 0.;
+	if ( m_Pro ) m_Pro -> BeginOfEvent();
+
+	// Sub-event parallel mode: counts of sub-events are collected here. This
+	// is per event, because the next event may start before all sub-events
+	// of this one are back.
+	if ( m_SubEvent && !m_SubEventWorker )
+		const_cast<G4Event*>(anEvent) -> SetUserInformation(new EveInf());
 }
 
 //////////////////////////////////////////////////
@@ -48,27 +113,244 @@ void EveAct::BeginOfEventAction(const G4Event* /* anEvent */)
 //////////////////////////////////////////////////
 void EveAct::EndOfEventAction(const G4Event* anEvent)
 {
+	if ( m_Pro ) m_Pro -> EndOfEvent();
+
+	// A sub-event is only a part of an event. Its counts are attached to it
+	// and merged into the mother event by MergeSubEvent().
+	if ( m_SubEventWorker )
+	{
+		const_cast<G4Event*>(anEvent) -> SetUserInformation(new EveInf(m_NScint, m_NCeren));
+		return;
+	}
+
+	// Counts from sub-events, if any
+	const EveInf* EI = dynamic_cast<const EveInf*>(anEvent -> GetUserInformation());
+	if ( EI )
+	{
+		m_NScint += EI -> GetNScint();
+		m_NCeren += EI -> GetNCeren();
+	}
+
 	// Get event ID
-	G4int eventID = anEvent -> GetEventID();
+	// In a sharded job, shards cover disjoint event ID ranges.
+	G4int eventID = anEvent -> GetEventID() + RunAct::GetEventIDOffset();
+
+	// Weighted photons at the ends, when photosensors see them
+	if ( m_ThinCol >= 0 && SenSD::IsEnabled() ) AddSensorWeights(anEvent);
+
+	// Summary mode: histograms instead of a row
+	if ( m_HisScint )
+	{
+		m_HisScint -> Fill(m_NScint);
+		m_HisCeren -> Fill(m_NCeren);
+	}
+	else
+	{
+		// Get output manager
+		auto OM = OutMan::Instance();
 
-	// Get analysis manager
-	auto AM = G4RootAnalysisManager::Instance();
+		OM -> FillI(0, eventID);
+		OM -> FillI(1, m_NScint);
+		OM -> FillI(2, m_NCeren);
+		if ( m_NDetCol >= 0 )
+		{
+			// Arrival time is -1 if nothing arrived.
+			OM -> FillI(m_NDetCol    , m_NDet[0]);
+			OM -> FillI(m_NDetCol + 1, m_NDet[1]);
+			OM -> FillD(m_NDetCol + 2, m_NDet[0] > 0 ? m_TDet[0] / ns : -1.);
+			OM -> FillD(m_NDetCol + 3, m_NDet[1] > 0 ? m_TDet[1] / ns : -1.);
+		}
+		if ( m_NSenCol >= 0 ) FillSensors(anEvent);
+		if ( m_Dig ) FillWaveforms();
+		if ( m_ThinCol >= 0 )
+		{
+			for ( G4int i = 0; i < kNWeighted; i++ )
+			{
+				OM -> FillD(m_ThinCol + i             , m_WSum[i]);
+				OM -> FillD(m_ThinCol + kNWeighted + i, m_WVar[i]);
+			}
+		}
+		if ( m_AccCol >= 0 )
+		{
+			OM -> FillI(m_AccCol    , m_AccKilled);
+			OM -> FillD(m_AccCol + 1, m_AccLost);
+		}
+		if ( m_CG && m_CosCol >= 0 )
+		{
+			OM -> FillD(m_CosCol    , m_CG -> GetLastEnergy() / GeV);
+			OM -> FillD(m_CosCol + 1, m_CG -> GetLastCosZ());
+			OM -> FillI(m_CosCol + 2, m_CG -> GetLastTries());
+		}
+		if ( m_Pro ) m_Pro -> Fill(m_ProCol);
+		OM -> AddRow();
+	}
 
-	AM -> FillNtupleIColumn(0, eventID);
-	AM -> FillNtupleIColumn(1, m_NScint);
-	AM -> FillNtupleIColumn(2, m_NCeren);
-	AM -> AddNtupleRow();
+	m_NEvents++;
+	m_SumScint += m_NScint;
+	m_SumScint2 += static_cast<G4double>(m_NScint) * m_NScint;
+	m_SumCeren += m_NCeren;
+	m_SumCeren2 += static_cast<G4double>(m_NCeren) * m_NCeren;
+	for ( G4int i = 0; m_ThinCol >= 0 && i < kNWeighted; i++ )
+	{
+		m_SumW[i] += m_WSum[i];
+		m_SumW2[i] += m_WSum[i] * m_WSum[i];
+	}
+	m_SumAccKilled += m_AccKilled;
+	m_SumAccLost += m_AccLost;
+	for ( G4int side = 0; side < 2; side++ )
+	{
+		m_SumDet[side] += m_NDet[side];
+		m_SumDet2[side] += static_cast<G4double>(m_NDet[side]) * m_NDet[side];
+	}
+}
+
+//////////////////////////////////////////////////
+//   Photosensor summary
+//////////////////////////////////////////////////
+void EveAct::FillSensors(const G4Event* anEvent)
+{
+	// Hits per end and the first arrival, -1 if nothing arrived
+	G4int nHits[2] = {0, 0};
+	G4double tFirst[2] = {-1., -1.};
+	const SenHitsCollection* HC = SenSD::GetHits(anEvent);
+	for ( std::size_t i = 0; HC && i < HC -> GetSize(); i++ )
+	{
+		const SenHit* hit = (*HC)[i];
+		G4int side = hit -> GetEnd() > 0 ? 0 : 1;
+		if ( nHits[side] == 0 || hit -> GetTime() < tFirst[side] ) tFirst[side] = hit -> GetTime();
+		nHits[side]++;
+		if ( m_Dig ) m_Times[side].push_back(hit -> GetTime());
+	}
+
+	auto OM = OutMan::Instance();
+	OM -> FillI(m_NSenCol    , nHits[0]);
+	OM -> FillI(m_NSenCol + 1, nHits[1]);
+	OM -> FillD(m_NSenCol + 2, nHits[0] > 0 ? tFirst[0] / ns : -1.);
+	OM -> FillD(m_NSenCol + 3, nHits[1] > 0 ? tFirst[1] / ns : -1.);
+}
+
+void EveAct::AddSensorWeights(const G4Event* anEvent)
+{
+	const SenHitsCollection* HC = SenSD::GetHits(anEvent);
+	for ( std::size_t i = 0; HC && i < HC -> GetSize(); i++ )
+	{
+		const SenHit* hit = (*HC)[i];
+		AddWeighted(hit -> GetEnd() > 0 ? kWEndPz : kWEndMz, hit -> GetWeight());
+	}
 }
 
 //////////////////////////////////////////////////
-//   Add optical photon
+//   Waveforms
 //////////////////////////////////////////////////
-void EveAct::AddScint()
+void EveAct::FillWaveforms()
 {
-	m_NScint++;
+	// Amplitude, threshold time and CFD time of each end
+	auto OM = OutMan::Instance();
+	for ( G4int side = 0; side < 2; side++ )
+	{
+		G4double amp, tThr, tCfd;
+		m_Dig -> Digitize(m_Times[side], amp, tThr, tCfd);
+		OM -> FillD(m_DigCol     + side, amp);
+		OM -> FillD(m_DigCol + 2 + side, tThr >= 0. ? tThr / ns : -1.);
+		OM -> FillD(m_DigCol + 4 + side, tCfd >= 0. ? tCfd / ns : -1.);
+	}
 }
 
-void EveAct::AddCeren()
+//////////////////////////////////////////////////
+//   Merge sub-event
+//////////////////////////////////////////////////
+#if G4VERSION_NUMBER >= 1130
+void EveAct::MergeSubEvent(G4Event* masterEvent, const G4Event* subEvent)
+{
+	const EveInf* subEI = dynamic_cast<const EveInf*>(subEvent -> GetUserInformation());
+	EveInf* masterEI = dynamic_cast<EveInf*>(masterEvent -> GetUserInformation());
+	if ( !subEI || !masterEI ) return;
+
+	// Sub-events finish on different workers, so be careful.
+	G4AutoLock lock(&mergeMutex);
+	masterEI -> Add(subEI -> GetNScint(), subEI -> GetNCeren());
+}
+#endif
+
+//////////////////////////////////////////////////
+//   Summary
+//////////////////////////////////////////////////
+void EveAct::ResetSummary()
+{
+	m_NEvents = 0;
+	m_SumScint = m_SumScint2 = 0.;
+	m_SumCeren = m_SumCeren2 = 0.;
+	for ( G4int i = 0; i < kNWeighted; i++ ) m_SumW[i] = m_SumW2[i] = 0.;
+	m_SumAccKilled = m_SumAccLost = 0.;
+	m_SumDet[0] = m_SumDet[1] = m_SumDet2[0] = m_SumDet2[1] = 0.;
+}
+
+void EveAct::PrintSummary() const
+{
+	G4double meanScint, errScint, meanCeren, errCeren;
+	if ( GetSummary(meanScint, errScint, meanCeren, errCeren) < 2 ) return;
+
+	G4cout << "mCP: nScint " << meanScint << " +- " << errScint
+	       << ", nCeren " << meanCeren << " +- " << errCeren
+	       << " per event (" << m_NEvents << " events)" << G4endl;
+
+	// Photons at the ends, with '--optics fast', 'calib' or 'trace'
+	if ( m_NDetCol >= 0 )
+	{
+		const char* names[2] = {"nDetPz", "nDetMz"};
+		G4cout << "mCP:";
+		for ( G4int side = 0; side < 2; side++ )
+		{
+			G4double mean = m_SumDet[side] / m_NEvents;
+			G4double var = (m_SumDet2[side] - m_NEvents * mean * mean) / (m_NEvents - 1);
+			G4cout << (side ? ", " : " ") << names[side] << " " << mean << " +- " << std::sqrt(std::max(var, 0.) / m_NEvents);
+		}
+		G4cout << " per event" << G4endl;
+	}
+
+	// '--acceptance': photons killed at creation, and at most how many of
+	// them would have arrived at an end
+	if ( m_AccCol >= 0 )
+		G4cout << "mCP: acceptance filter killed " << m_SumAccKilled / m_NEvents << " photons, losing at most "
+		       << m_SumAccLost / m_NEvents << " at the ends, per event" << G4endl;
+
+	// '--thin': the same from weighted photons, and at the ends. The error
+	// includes the thinning noise.
+	if ( m_ThinCol < 0 ) return;
+	const char* names[kNWeighted] = {"nScint", "nCeren", "nEndPz", "nEndMz"};
+	G4cout << "mCP: weighted";
+	for ( G4int i = 0; i < kNWeighted; i++ )
+	{
+		G4double mean = m_SumW[i] / m_NEvents;
+		G4double var = (m_SumW2[i] - m_NEvents * mean * mean) / (m_NEvents - 1);
+		G4cout << (i ? ", " : " ") << names[i] << " " << mean << " +- " << std::sqrt(std::max(var, 0.) / m_NEvents);
+	}
+	G4cout << " per event" << G4endl;
+}
+
+G4int EveAct::GetSummary(G4double& meanScint, G4double& errScint, G4double& meanCeren, G4double& errCeren) const
+{
+	meanScint = errScint = meanCeren = errCeren = 0.;
+	if ( m_NEvents < 1 ) return m_NEvents;
+
+	meanScint = m_SumScint / m_NEvents;
+	meanCeren = m_SumCeren / m_NEvents;
+	if ( m_NEvents < 2 ) return m_NEvents;
+
+	// Error of the mean from the sample variance
+	G4double varScint = (m_SumScint2 - m_NEvents * meanScint * meanScint) / (m_NEvents - 1);
+	G4double varCeren = (m_SumCeren2 - m_NEvents * meanCeren * meanCeren) / (m_NEvents - 1);
+	errScint = std::sqrt(std::max(varScint, 0.) / m_NEvents);
+	errCeren = std::sqrt(std::max(varCeren, 0.) / m_NEvents);
+
+	return m_NEvents;
+}
+
+//////////////////////////////////////////////////
+//   Sub-event mode
+//////////////////////////////////////////////////
+void EveAct::SetSubEventMode(G4bool worker)
 {
-	m_NCeren++;
+	m_SubEvent = true;
+	m_SubEventWorker = worker;
 }
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+//   EveInf.cc
+//
+//   Definitions of EveInf class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "EveInf.hh"
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+EveInf::EveInf(G4int nScint, G4int nCeren): G4VUserEventInformation(), m_NScint(nScint), m_NCeren(nCeren)
+{
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+EveInf::~EveInf()
+{
+}
+
+//////////////////////////////////////////////////
+//   Add counts
+//////////////////////////////////////////////////
+void EveInf::Add(G4int nScint, G4int nCeren)
+{
+	m_NScint += nScint;
+	m_NCeren += nCeren;
+}
+
+//////////////////////////////////////////////////
+//   Print
+//////////////////////////////////////////////////
+void EveInf::Print() const
+{
+	G4cout << "EveInf: nScint " << m_NScint << ", nCeren " << m_NCeren << G4endl;
+}
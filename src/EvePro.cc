@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//   EvePro.cc
+//
+//   Definitions of EvePro class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4SystemOfUnits.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Gamma.hh"
+#include "G4OpticalPhoton.hh"
+
+#include "EvePro.hh"
+#include "RunAct.hh"
+#include "OutMan.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+EvePro::EvePro()
+{
+	m_MuM = G4MuonMinus::Definition();
+	m_MuP = G4MuonPlus::Definition();
+	m_ElM = G4Electron::Definition();
+	m_ElP = G4Positron::Definition();
+	m_Gam = G4Gamma::Definition();
+	m_Opt = G4OpticalPhoton::Definition();
+
+	m_CPUStart = 0.;
+	BeginOfEvent();
+}
+
+EvePro::~EvePro()
+{
+}
+
+//////////////////////////////////////////////////
+//   Columns
+//////////////////////////////////////////////////
+void EvePro::AddColumns()
+{
+	// Fill() relies on this order.
+	RunAct::AddColumn("tWall"     , 'D'); // ms
+	RunAct::AddColumn("tCPU"      , 'D'); // ms, of this thread
+	RunAct::AddColumn("nSteps"    , 'I');
+	RunAct::AddColumn("nStepsMu"  , 'I');
+	RunAct::AddColumn("nStepsE"   , 'I');
+	RunAct::AddColumn("nStepsGam" , 'I');
+	RunAct::AddColumn("nStepsOpt" , 'I');
+	RunAct::AddColumn("maxStack"  , 'I');
+	RunAct::AddColumn("nPhoMade"  , 'I');
+	RunAct::AddColumn("nPhoKilled", 'I');
+}
+
+//////////////////////////////////////////////////
+//   Begin and end of event
+//////////////////////////////////////////////////
+void EvePro::BeginOfEvent()
+{
+	m_Wall = m_CPU = 0.;
+	m_NSteps = m_NStepsMu = m_NStepsE = m_NStepsGam = m_NStepsOpt = 0;
+	m_MaxStack = 0;
+	m_NPhoMade = m_NPhoKilled = 0;
+
+	m_WallStart = std::chrono::steady_clock::now();
+	m_CPUStart = CPUTime();
+}
+
+void EvePro::EndOfEvent()
+{
+	m_Wall = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - m_WallStart).count() * s;
+	m_CPU = CPUTime() - m_CPUStart;
+}
+
+G4double EvePro::CPUTime()
+{
+	// Of this thread, not of the process
+	timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (ts.tv_sec + 1.e-9 * ts.tv_nsec) * s;
+}
+
+//////////////////////////////////////////////////
+//   Fill
+//////////////////////////////////////////////////
+void EvePro::Fill(G4int firstCol) const
+{
+	auto OM = OutMan::Instance();
+
+	OM -> FillD(firstCol    , m_Wall / ms);
+	OM -> FillD(firstCol + 1, m_CPU / ms);
+	OM -> FillI(firstCol + 2, m_NSteps);
+	OM -> FillI(firstCol + 3, m_NStepsMu);
+	OM -> FillI(firstCol + 4, m_NStepsE);
+	OM -> FillI(firstCol + 5, m_NStepsGam);
+	OM -> FillI(firstCol + 6, m_NStepsOpt);
+	OM -> FillI(firstCol + 7, m_MaxStack);
+	OM -> FillI(firstCol + 8, m_NPhoMade);
+	OM -> FillI(firstCol + 9, m_NPhoKilled);
+}
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//   FilMes.cc
+//
+//   Definitions of FilMes class's member functions. Macro commands for the
+// stepping filter live under /mCP/filter/.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include "FilMes.hh"
+#include "SteFil.hh"
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+FilMes::FilMes(SteFil* SF): G4UImessenger(), m_SF(SF)
+{
+	m_Dir = new G4UIdirectory("/mCP/");
+	m_Dir -> SetGuidance("mCP specific controls.");
+
+	m_FilDir = new G4UIdirectory("/mCP/filter/");
+	m_FilDir -> SetGuidance("Stepping filter controls.");
+	m_FilDir -> SetGuidance("A step is matched if its particle and post-step volume are listed.");
+	m_FilDir -> SetGuidance("Matched tracks are counted by creator process and killed.");
+	m_FilDir -> SetGuidance("Changes take effect at the next /run/beamOn.");
+
+	m_VolCmd = new G4UIcmdWithAString("/mCP/filter/addVolume", this);
+	m_VolCmd -> SetGuidance("Add a physical volume to match on (post-step point).");
+	m_VolCmd -> SetParameterName("volume", false);
+	m_VolCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_ParCmd = new G4UIcmdWithAString("/mCP/filter/addParticle", this);
+	m_ParCmd -> SetGuidance("Add a particle to match on.");
+	m_ParCmd -> SetParameterName("particle", false);
+	m_ParCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_ScintCmd = new G4UIcmdWithAString("/mCP/filter/addScintProcess", this);
+	m_ScintCmd -> SetGuidance("Add a creator process counted as nScint.");
+	m_ScintCmd -> SetParameterName("process", false);
+	m_ScintCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_CerenCmd = new G4UIcmdWithAString("/mCP/filter/addCerenProcess", this);
+	m_CerenCmd -> SetGuidance("Add a creator process counted as nCeren.");
+	m_CerenCmd -> SetParameterName("process", false);
+	m_CerenCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_ResetCmd = new G4UIcmdWithoutParameter("/mCP/filter/reset", this);
+	m_ResetCmd -> SetGuidance("Remove all conditions. Nothing is matched afterwards.");
+	m_ResetCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_ListCmd = new G4UIcmdWithoutParameter("/mCP/filter/list", this);
+	m_ListCmd -> SetGuidance("Print current conditions.");
+	m_ListCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_KillCmd = new G4UIcmdWithABool("/mCP/filter/kill", this);
+	m_KillCmd -> SetGuidance("Kill matched tracks (default true).");
+	m_KillCmd -> SetGuidance("If false, a track is matched only at its first step and keeps going.");
+	m_KillCmd -> SetParameterName("kill", true);
+	m_KillCmd -> SetDefaultValue(true);
+	m_KillCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_LegacyCmd = new G4UIcmdWithABool("/mCP/filter/legacy", this);
+	m_LegacyCmd -> SetGuidance("Use the old string comparing stepping action (default false).");
+	m_LegacyCmd -> SetGuidance("Only meant for benchmarking. Conditions above are ignored.");
+	m_LegacyCmd -> SetParameterName("legacy", true);
+	m_LegacyCmd -> SetDefaultValue(true);
+	m_LegacyCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+FilMes::~FilMes()
+{
+	delete m_LegacyCmd;
+	delete m_KillCmd;
+	delete m_ListCmd;
+	delete m_ResetCmd;
+	delete m_CerenCmd;
+	delete m_ScintCmd;
+	delete m_ParCmd;
+	delete m_VolCmd;
+	delete m_FilDir;
+	delete m_Dir;
+}
+
+//////////////////////////////////////////////////
+//   Set new value
+//////////////////////////////////////////////////
+void FilMes::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+	if      ( command == m_VolCmd   ) m_SF -> AddVolume(newValue);
+	else if ( command == m_ParCmd   ) m_SF -> AddParticle(newValue);
+	else if ( command == m_ScintCmd ) m_SF -> AddScintProcess(newValue);
+	else if ( command == m_CerenCmd ) m_SF -> AddCerenProcess(newValue);
+	else if ( command == m_ResetCmd ) m_SF -> Reset();
+	else if ( command == m_ListCmd  ) m_SF -> List();
+	else if ( command == m_KillCmd  ) m_SF -> SetKill(m_KillCmd -> GetNewBoolValue(newValue));
+	else if ( command == m_LegacyCmd ) m_SF -> SetLegacy(m_LegacyCmd -> GetNewBoolValue(newValue));
+}
+
+//////////////////////////////////////////////////
+//   Get current value
+//////////////////////////////////////////////////
+G4String FilMes::GetCurrentValue(G4UIcommand* command)
+{
+	if ( command == m_KillCmd   ) return m_KillCmd   -> ConvertToString(m_SF -> GetKill());
+	if ( command == m_LegacyCmd ) return m_LegacyCmd -> ConvertToString(m_SF -> GetLegacy());
+
+	return "";
+}
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+//   HisAcc.cc
+//
+//   Definitions of HisAcc class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "HisAcc.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+HisAcc::HisAcc(const G4String& name, G4int nBins, G4double min, G4double max): G4VAccumulable(name)
+{
+	m_Min = min;
+	m_Max = max;
+	m_InvWidth = nBins / (max - min);
+	m_Bins.assign(nBins + 2, 0.);
+
+	m_Entries = 0;
+	m_SumW = m_SumWX = m_SumWX2 = 0.;
+}
+
+HisAcc::~HisAcc()
+{
+}
+
+//////////////////////////////////////////////////
+//   Merge and reset
+//////////////////////////////////////////////////
+void HisAcc::Merge(const G4VAccumulable& other)
+{
+	const HisAcc& his = static_cast<const HisAcc&>(other);
+	for ( std::size_t i = 0; i < m_Bins.size(); i++ ) m_Bins[i] += his.m_Bins[i];
+
+	m_Entries += his.m_Entries;
+	m_SumW += his.m_SumW;
+	m_SumWX += his.m_SumWX;
+	m_SumWX2 += his.m_SumWX2;
+}
+
+void HisAcc::Reset()
+{
+	std::fill(m_Bins.begin(), m_Bins.end(), 0.);
+
+	m_Entries = 0;
+	m_SumW = m_SumWX = m_SumWX2 = 0.;
+}
+
+//////////////////////////////////////////////////
+//   Write
+//////////////////////////////////////////////////
+void HisAcc::Write(std::ostream& os) const
+{
+	const G4int nBins = m_Bins.size() - 2;
+	G4double mean = m_SumW > 0. ? m_SumWX / m_SumW : 0.;
+	G4double rms = m_SumW > 0. ? std::sqrt(std::max(m_SumWX2 / m_SumW - mean * mean, 0.)) : 0.;
+
+	os << "# " << GetName() << " nBins " << nBins << " min " << m_Min << " max " << m_Max
+	   << " entries " << m_Entries << " sumW " << m_SumW << " mean " << mean << " rms " << rms
+	   << " underflow " << m_Bins.front() << " overflow " << m_Bins.back() << "\n";
+	for ( G4int i = 1; i <= nBins; i++ )
+		os << m_Min + (i - 0.5) / m_InvWidth << " " << m_Bins[i] << "\n";
+}
@@ -0,0 +1,427 @@
+////////////////////////////////////////////////////////////////////////////////
+//   MatDat.cc
+//
+//   Definitions of MatDat class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "G4Material.hh"
+#include "G4Element.hh"
+#include "G4NistManager.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "MatDat.hh"
+
+G4String MatDat::s_FileName = "materials/mCP.mat";
+
+namespace
+{
+	const std::vector<std::pair<G4String, G4State>> states =
+	{
+		{"solid", kStateSolid}, {"liquid", kStateLiquid}, {"gas", kStateGas},
+	};
+
+	const std::vector<std::pair<G4String, G4SurfaceType>> types =
+	{
+		{"dielectric_metal"     , dielectric_metal     },
+		{"dielectric_dielectric", dielectric_dielectric},
+		{"dielectric_LUT"       , dielectric_LUT       },
+		{"dielectric_LUTDAVIS"  , dielectric_LUTDAVIS  },
+		{"dielectric_dichroic"  , dielectric_dichroic  },
+	};
+
+	const std::vector<std::pair<G4String, G4OpticalSurfaceModel>> models =
+	{
+		{"glisur", glisur}, {"unified", unified}, {"LUT", LUT}, {"DAVIS", DAVIS}, {"dichroic", dichroic},
+	};
+
+	const std::vector<std::pair<G4String, G4OpticalSurfaceFinish>> finishes =
+	{
+		{"polished"             , polished             },
+		{"polishedfrontpainted" , polishedfrontpainted },
+		{"polishedbackpainted"  , polishedbackpainted  },
+		{"ground"               , ground               },
+		{"groundfrontpainted"   , groundfrontpainted   },
+		{"groundbackpainted"    , groundbackpainted    },
+		{"Rough_LUT"            , Rough_LUT            },
+		{"RoughTeflon_LUT"      , RoughTeflon_LUT      },
+		{"RoughESR_LUT"         , RoughESR_LUT         },
+		{"RoughESRGrease_LUT"   , RoughESRGrease_LUT   },
+		{"Polished_LUT"         , Polished_LUT         },
+		{"PolishedTeflon_LUT"   , PolishedTeflon_LUT   },
+		{"PolishedESR_LUT"      , PolishedESR_LUT      },
+		{"PolishedESRGrease_LUT", PolishedESRGrease_LUT},
+		{"Detector_LUT"         , Detector_LUT         },
+	};
+
+	template <typename T>
+	G4bool FromName(const std::vector<std::pair<G4String, T>>& table, const G4String& name, T& value)
+	{
+		for ( const auto& entry: table )
+		{
+			if ( entry.first != name ) continue;
+			value = entry.second;
+			return true;
+		}
+		return false;
+	}
+
+	// Relative difference below which two values are the same
+	const G4double tolerance = 1.e-9;
+
+	G4bool Same(G4double a, G4double b)
+	{
+		return std::abs(a - b) <= tolerance * std::max(std::abs(a), std::abs(b));
+	}
+}
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+MatDat::MatDat()
+{
+	m_Line = 0;
+	m_Compact = true;
+}
+
+MatDat::~MatDat()
+{
+	// Tables first, as DetCon always did
+	for ( auto MPT: m_MPTs ) delete MPT;
+	for ( auto mat: m_Materials ) delete mat;
+}
+
+//////////////////////////////////////////////////
+//   Data file of this job
+//////////////////////////////////////////////////
+void MatDat::SetFileName(const G4String& fileName)
+{
+	s_FileName = fileName;
+}
+
+const G4String& MatDat::GetFileName()
+{
+#ifdef MCP_DATA_DIR
+	// Default file not in the working directory: the installed one. main()
+	// asks first, before there are other threads.
+	static const G4String installed = MCP_DATA_DIR "/materials/mCP.mat";
+	if ( s_FileName == "materials/mCP.mat" && !std::ifstream(s_FileName).good() ) s_FileName = installed;
+#endif
+	return s_FileName;
+}
+
+//////////////////////////////////////////////////
+//   Load
+//////////////////////////////////////////////////
+void MatDat::Load(const G4String& fileName)
+{
+	m_FileName = fileName;
+	m_Line = 0;
+	std::ifstream file(fileName);
+	if ( !file ) Error("cannot open the file");
+
+	// Reads "<value> <unit>" from the rest of a line
+	auto Unit = [this](const std::string& unit) -> G4double
+	{
+		if ( unit == "1" ) return 1.;
+		G4bool inverse = unit.size() > 2 && unit.substr(0, 2) == "1/";
+		G4String name = inverse ? unit.substr(2) : unit;
+		if ( !G4UnitDefinition::IsUnitDefined(name) ) Error("unknown unit '" + unit + "'");
+		G4double value = G4UnitDefinition::GetValueOf(name);
+		return inverse ? 1. / value : value;
+	};
+	auto Quantity = [&Unit, this](std::istringstream& iss) -> G4double
+	{
+		G4double value;
+		std::string unit;
+		if ( !(iss >> value >> unit) ) Error("a value and its unit are expected");
+		return value * Unit(unit);
+	};
+
+	// Material or surface being read
+	G4String blockType, blockName;
+	G4double density = 0., temperature = NTP_Temperature, birks = 0.;
+	G4State state = kStateUndefined;
+	std::vector<std::pair<G4String, G4double>> elements;
+	G4MaterialPropertiesTable* MPT = 0;
+	G4SurfaceType type = dielectric_dielectric;
+	G4OpticalSurfaceFinish finish = polished;
+	G4OpticalSurfaceModel model = glisur;
+	G4double sigmaAlpha = -1., polish = -1.;
+
+	std::string line;
+	while ( std::getline(file, line) )
+	{
+		m_Line++;
+		line = line.substr(0, line.find('#'));
+		std::istringstream iss(line);
+		std::string word;
+		if ( !(iss >> word) ) continue;
+
+		// Outside of blocks
+		if ( blockType.empty() )
+		{
+			if ( word == "compact" )
+			{
+				iss >> word;
+				if ( word != "on" && word != "off" ) Error("compact is on or off");
+				m_Compact = word == "on";
+			}
+			else if ( word == "world" || word == "lab" || word == "bar" || word == "sensor" )
+			{
+				std::string name;
+				if ( !(iss >> name) ) Error("a material name is expected");
+				m_Volumes[word] = name;
+			}
+			else if ( word == "material" || word == "surface" )
+			{
+				blockType = word;
+				std::string name;
+				if ( !(iss >> name) ) Error("a name is expected");
+				blockName = name;
+				density = 0.;
+				temperature = NTP_Temperature;
+				birks = 0.;
+				state = kStateUndefined;
+				elements.clear();
+				MPT = new G4MaterialPropertiesTable();
+				type = dielectric_dielectric;
+				finish = polished;
+				model = glisur;
+				sigmaAlpha = -1.;
+				polish = -1.;
+			}
+			else Error("unknown statement '" + word + "'");
+			continue;
+		}
+
+		// Property table of a material or a surface
+		if ( word == "property" )
+		{
+			std::string key, energyUnit, valueUnit, option;
+			if ( !(iss >> key >> energyUnit >> valueUnit) ) Error("property needs a key, an energy unit and a value unit");
+			G4bool spline = (iss >> option) && option == "spline";
+			G4double eUnit = Unit(energyUnit), vUnit = Unit(valueUnit);
+
+			std::vector<G4double> energies, values;
+			G4bool closed = false;
+			while ( std::getline(file, line) )
+			{
+				m_Line++;
+				line = line.substr(0, line.find('#'));
+				std::istringstream pss(line);
+				std::string first;
+				if ( !(pss >> first) ) continue;
+				if ( first == "end" ) { closed = true; break; }
+				G4double energy, value;
+				std::istringstream fss(first);
+				if ( !(fss >> energy) || !(pss >> value) ) Error("\"energy value\" is expected");
+				if ( !energies.empty() && energy * eUnit <= energies.back() ) Error("energies must increase");
+				energies.push_back(energy * eUnit);
+				values.push_back(value * vUnit);
+			}
+			if ( !closed ) Error("property " + key + " has no end");
+			if ( energies.empty() ) Error("property " + key + " is empty");
+			AddProperty(MPT, blockName, key, energies, values, spline);
+			continue;
+		}
+
+		// End of block
+		if ( word == "end" )
+		{
+			if ( blockType == "material" )
+			{
+				if ( density <= 0. || elements.empty() ) Error("material " + blockName + " needs a density and elements");
+				G4Material* mat = new G4Material(blockName, density, elements.size(), state, temperature);
+				G4double sum = 0.;
+				for ( const auto& el: elements ) sum += el.second;
+				for ( const auto& el: elements )
+				{
+					// Elements made by DetCon first, then NIST ones
+					G4Element* element = 0;
+					for ( G4Element* known: *G4Element::GetElementTable() )
+						if ( known -> GetSymbol() == el.first ) { element = known; break; }
+					if ( !element ) element = G4NistManager::Instance() -> FindOrBuildElement(el.first);
+					if ( !element ) Error("unknown element '" + el.first + "'");
+					mat -> AddElement(element, el.second / sum);
+				}
+				if ( birks > 0. ) mat -> GetIonisation() -> SetBirksConstant(birks);
+				mat -> SetMaterialPropertiesTable(MPT);
+				m_Materials.push_back(mat);
+				m_MPTs.push_back(MPT);
+			}
+			else
+			{
+				G4OpticalSurface* opS = new G4OpticalSurface(blockName);
+				opS -> SetType(type);
+				opS -> SetFinish(finish);
+				opS -> SetModel(model);
+				if ( sigmaAlpha >= 0. ) opS -> SetSigmaAlpha(sigmaAlpha);
+				if ( polish     >= 0. ) opS -> SetPolish(polish);
+				opS -> SetMaterialPropertiesTable(MPT);
+				m_Surfaces[blockName] = opS;
+			}
+			blockType = "";
+			MPT = 0;
+			continue;
+		}
+
+		// Statements of a block
+		if ( word == "const" )
+		{
+			std::string key;
+			if ( !(iss >> key) ) Error("const needs a key");
+			G4double value = Quantity(iss);
+			const auto& names = MPT -> GetMaterialConstPropertyNames();
+			G4bool known = std::find(names.begin(), names.end(), key) != names.end();
+			MPT -> AddConstProperty(key, value, !known);
+		}
+		else if ( blockType == "material" )
+		{
+			if      ( word == "density"     ) density = Quantity(iss);
+			else if ( word == "temperature" ) temperature = Quantity(iss);
+			else if ( word == "birks"       ) birks = Quantity(iss);
+			else if ( word == "state" )
+			{
+				iss >> word;
+				if ( !FromName(states, G4String(word), state) ) Error("unknown state '" + word + "'");
+			}
+			else if ( word == "element" )
+			{
+				std::string symbol;
+				G4double weight;
+				if ( !(iss >> symbol >> weight) || weight <= 0. ) Error("element needs a symbol and a positive weight");
+				elements.push_back(std::make_pair(symbol, weight));
+			}
+			else Error("unknown material statement '" + word + "'");
+		}
+		else
+		{
+			if ( word == "type" )
+			{
+				iss >> word;
+				if ( !FromName(types, G4String(word), type) ) Error("unknown surface type '" + word + "'");
+			}
+			else if ( word == "finish" )
+			{
+				iss >> word;
+				if ( !FromName(finishes, G4String(word), finish) ) Error("unknown surface finish '" + word + "'");
+			}
+			else if ( word == "model" )
+			{
+				iss >> word;
+				if ( !FromName(models, G4String(word), model) ) Error("unknown surface model '" + word + "'");
+			}
+			else if ( word == "sigmaAlpha" ) iss >> sigmaAlpha;
+			else if ( word == "polish"     ) iss >> polish;
+			else Error("unknown surface statement '" + word + "'");
+		}
+	}
+	if ( !blockType.empty() ) Error(blockType + " " + blockName + " has no end");
+
+	for ( const char* volume: {"world", "lab", "bar"} )
+		if ( !GetMaterial(volume) ) Error(G4String("no material for the ") + volume);
+}
+
+//////////////////////////////////////////////////
+//   Property tables
+//////////////////////////////////////////////////
+void MatDat::AddProperty(G4MaterialPropertiesTable* MPT, const G4String& owner, const G4String& key,
+                         std::vector<G4double>& energies, std::vector<G4double>& values, G4bool spline)
+{
+	std::size_t nPoints = energies.size();
+	if ( m_Compact && nPoints > 2 )
+	{
+		G4bool constant = true;
+		for ( G4double value: values ) constant = constant && Same(value, values[0]);
+
+		if ( constant )
+		{
+			// Spline of a constant is the same constant.
+			energies = {energies.front(), energies.back()};
+			values = {values[0], values[0]};
+			spline = false;
+		}
+		else if ( !spline )
+		{
+			// A point is dropped if it and every point dropped since the last
+			// one kept lie on the line to the next point.
+			std::vector<G4double> e = {energies[0]}, v = {values[0]};
+			std::size_t kept = 0;
+			for ( std::size_t i = 1; i + 1 < nPoints; i++ )
+			{
+				G4bool onLine = true;
+				for ( std::size_t j = kept + 1; j <= i && onLine; j++ )
+				{
+					G4double t = (energies[j] - energies[kept]) / (energies[i + 1] - energies[kept]);
+					onLine = Same(values[j], values[kept] + t * (values[i + 1] - values[kept]));
+				}
+				if ( onLine ) continue;
+				e.push_back(energies[i]);
+				v.push_back(values[i]);
+				kept = i;
+			}
+			e.push_back(energies.back());
+			v.push_back(values.back());
+			energies.swap(e);
+			values.swap(v);
+		}
+	}
+	if ( energies.size() != nPoints )
+		G4cout << "mCP: " << owner << " " << key << " compacted from " << nPoints << " to " << energies.size() << " points" << G4endl;
+
+	// RINDEX makes GROUPVEL here.
+	const auto& names = MPT -> GetMaterialPropertyNames();
+	G4bool known = std::find(names.begin(), names.end(), key) != names.end();
+	MPT -> AddProperty(key, energies, values, !known, spline);
+}
+
+//////////////////////////////////////////////////
+//   Getters
+//////////////////////////////////////////////////
+G4Material* MatDat::GetMaterial(const G4String& volume) const
+{
+	auto it = m_Volumes.find(volume);
+	if ( it == m_Volumes.end() ) return 0;
+
+	return G4Material::GetMaterial(it -> second, false);
+}
+
+G4OpticalSurface* MatDat::GetSurface(const G4String& name) const
+{
+	auto it = m_Surfaces.find(name);
+	return it == m_Surfaces.end() ? 0 : it -> second;
+}
+
+G4bool MatDat::FinishFromName(const G4String& name, G4OpticalSurfaceFinish& finish)
+{
+	return FromName(finishes, name, finish);
+}
+
+G4String MatDat::NameOfFinish(G4OpticalSurfaceFinish finish)
+{
+	for ( const auto& entry: finishes )
+		if ( entry.second == finish ) return entry.first;
+
+	return "";
+}
+
+//////////////////////////////////////////////////
+//   Error
+//////////////////////////////////////////////////
+void MatDat::Error(const G4String& message) const
+{
+	G4ExceptionDescription ed;
+	ed << m_FileName;
+	if ( m_Line > 0 ) ed << ":" << m_Line;
+	ed << ": " << message << ".";
+	G4Exception("mCP::MatDat", "mCP011", FatalException, ed);
+}
@@ -0,0 +1,342 @@
+////////////////////////////////////////////////////////////////////////////////
+//   OptMap.cc
+//
+//   Definitions of OptMap class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "G4SystemOfUnits.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4Box.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4LogicalBorderSurface.hh"
+#include "G4OpticalSurface.hh"
+#include "G4AutoLock.hh"
+
+#include "OptMap.hh"
+
+namespace
+{
+	G4Mutex calibMutex = G4MUTEX_INITIALIZER;
+
+	// Shared map of fast mode and accumulated map of calibration mode
+	OptMap* sharedMap = 0;
+	OptMap* calibMap = 0;
+
+	// Map file format version. Bump it whenever the binning changes.
+	const char* mapMagic = "mCPOptMap v1";
+}
+
+const G4double OptMap::s_TMax = 50. * ns;
+OptMap::Mode OptMap::s_Mode = OptMap::kFull;
+G4String OptMap::s_Dir = ".";
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+OptMap::OptMap()
+{
+	m_HalfZ = 0.;
+}
+
+OptMap::~OptMap()
+{
+}
+
+//////////////////////////////////////////////////
+//   Mode
+//////////////////////////////////////////////////
+void OptMap::Configure(Mode mode, const G4String& dir)
+{
+	s_Mode = mode;
+	s_Dir = dir;
+}
+
+OptMap::Mode OptMap::GetMode()
+{
+	return s_Mode;
+}
+
+//////////////////////////////////////////////////
+//   Book and reset
+//////////////////////////////////////////////////
+void OptMap::Book(G4double halfZ, const G4String& key)
+{
+	m_HalfZ = halfZ;
+	m_Key = key;
+
+	const G4int nBins = s_NZ * s_NDir;
+	m_NEmitted .assign(nBins, 0.);
+	m_NDetected.assign(2 * nBins, 0.);
+	m_NTime    .assign(2 * nBins * s_NT, 0.);
+	m_Prob     .clear();
+	m_TimeCDF  .clear();
+}
+
+void OptMap::Reset()
+{
+	std::fill(m_NEmitted .begin(), m_NEmitted .end(), 0.);
+	std::fill(m_NDetected.begin(), m_NDetected.end(), 0.);
+	std::fill(m_NTime    .begin(), m_NTime    .end(), 0.);
+}
+
+//////////////////////////////////////////////////
+//   Merge
+//////////////////////////////////////////////////
+void OptMap::Merge(const OptMap& other)
+{
+	if ( !IsBooked() ) Book(other.m_HalfZ, other.m_Key);
+	if ( other.m_Key != m_Key ) return;
+
+	for ( std::size_t i = 0; i < m_NEmitted .size(); i++ ) m_NEmitted [i] += other.m_NEmitted [i];
+	for ( std::size_t i = 0; i < m_NDetected.size(); i++ ) m_NDetected[i] += other.m_NDetected[i];
+	for ( std::size_t i = 0; i < m_NTime    .size(); i++ ) m_NTime    [i] += other.m_NTime    [i];
+}
+
+//////////////////////////////////////////////////
+//   Finalize
+//////////////////////////////////////////////////
+void OptMap::Finalize()
+{
+	const G4int nBins = s_NZ * s_NDir;
+	m_Prob.assign(2 * nBins, 0.f);
+	m_TimeCDF.assign(2 * nBins * s_NT, 1.f);
+
+	for ( G4int side = 0; side < 2; side++ )
+	{
+		for ( G4int bin = 0; bin < nBins; bin++ )
+		{
+			G4int sBin = side * nBins + bin;
+			if ( m_NEmitted[bin] > 0. ) m_Prob[sBin] = m_NDetected[sBin] / m_NEmitted[bin];
+			if ( m_NDetected[sBin] <= 0. ) continue;
+
+			G4double sum = 0.;
+			for ( G4int it = 0; it < s_NT; it++ )
+			{
+				sum += m_NTime[sBin * s_NT + it];
+				m_TimeCDF[sBin * s_NT + it] = sum / m_NDetected[sBin];
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////
+//   Save and load
+//////////////////////////////////////////////////
+G4bool OptMap::Save(const G4String& fileName) const
+{
+	// Write to a temporary file and move it, so that a job reading the map
+	// never sees half of it.
+	G4String tmpName = fileName + ".tmp";
+	std::ofstream file(tmpName, std::ios::binary);
+	if ( !file ) return false;
+
+	std::uint32_t keyLength = m_Key.size();
+	std::int32_t nz = s_NZ, nDir = s_NDir, nt = s_NT;
+	file.write(mapMagic, std::strlen(mapMagic) + 1);
+	file.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+	file.write(m_Key.data(), keyLength);
+	file.write(reinterpret_cast<const char*>(&nz  ), sizeof(nz  ));
+	file.write(reinterpret_cast<const char*>(&nDir), sizeof(nDir));
+	file.write(reinterpret_cast<const char*>(&nt  ), sizeof(nt  ));
+	file.write(reinterpret_cast<const char*>(&m_HalfZ), sizeof(m_HalfZ));
+	file.write(reinterpret_cast<const char*>(m_NEmitted .data()), m_NEmitted .size() * sizeof(G4double));
+	file.write(reinterpret_cast<const char*>(m_NDetected.data()), m_NDetected.size() * sizeof(G4double));
+	file.write(reinterpret_cast<const char*>(m_NTime    .data()), m_NTime    .size() * sizeof(G4double));
+	file.close();
+	if ( !file ) return false;
+
+	return std::rename(tmpName.c_str(), fileName.c_str()) == 0;
+}
+
+G4bool OptMap::Load(const G4String& fileName, const G4String& key)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if ( !file ) return false;
+
+	std::vector<char> magic(std::strlen(mapMagic) + 1);
+	file.read(magic.data(), magic.size());
+	if ( !file || std::string(magic.data()) != mapMagic ) return false;
+
+	std::uint32_t keyLength = 0;
+	file.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength));
+	std::string fileKey(keyLength, ' ');
+	file.read(&fileKey[0], keyLength);
+	if ( !file || fileKey != key ) return false;
+
+	std::int32_t nz = 0, nDir = 0, nt = 0;
+	G4double halfZ = 0.;
+	file.read(reinterpret_cast<char*>(&nz   ), sizeof(nz   ));
+	file.read(reinterpret_cast<char*>(&nDir ), sizeof(nDir ));
+	file.read(reinterpret_cast<char*>(&nt   ), sizeof(nt   ));
+	file.read(reinterpret_cast<char*>(&halfZ), sizeof(halfZ));
+	if ( !file || nz != s_NZ || nDir != s_NDir || nt != s_NT ) return false;
+
+	Book(halfZ, key);
+	file.read(reinterpret_cast<char*>(m_NEmitted .data()), m_NEmitted .size() * sizeof(G4double));
+	file.read(reinterpret_cast<char*>(m_NDetected.data()), m_NDetected.size() * sizeof(G4double));
+	file.read(reinterpret_cast<char*>(m_NTime    .data()), m_NTime    .size() * sizeof(G4double));
+	if ( !file )
+	{
+		m_Key = "";
+		return false;
+	}
+
+	Finalize();
+	return true;
+}
+
+//////////////////////////////////////////////////
+//   Key
+//////////////////////////////////////////////////
+G4String OptMap::ComputeKey(G4double& halfZ)
+{
+	// Everything that changes where photons go. Numbers are written out in
+	// full, so the key itself is stored in the file and compared on load.
+	std::ostringstream key;
+	key << std::setprecision(12);
+	key << "nz=" << s_NZ << ";ndir=" << s_NDir << ";nt=" << s_NT << ";tmax=" << s_TMax / ns;
+
+	halfZ = 0.;
+	G4LogicalVolume* sciLV = G4LogicalVolumeStore::GetInstance() -> GetVolume("SciLV", false);
+	G4LogicalVolume* labLV = G4LogicalVolumeStore::GetInstance() -> GetVolume("LabLV", false);
+	if ( !sciLV || !labLV ) return "";
+
+	// No photosensors here: '--sensors' goes with '--optics full' only.
+	std::vector<G4LogicalVolume*> LVs = {sciLV, labLV};
+
+	// Dimensions
+	for ( G4LogicalVolume* LV: LVs )
+	{
+		const G4Box* box = dynamic_cast<const G4Box*>(LV -> GetSolid());
+		if ( !box ) return "";
+		key << ";" << LV -> GetName() << "=" << box -> GetXHalfLength() / mm << "," << box -> GetYHalfLength() / mm << "," << box -> GetZHalfLength() / mm;
+		if ( LV == sciLV ) halfZ = box -> GetZHalfLength();
+	}
+
+	// Optical properties of the materials
+	for ( G4LogicalVolume* LV: LVs )
+	{
+		G4Material* mat = LV -> GetMaterial();
+		key << ";" << mat -> GetName();
+		G4MaterialPropertiesTable* MPT = mat -> GetMaterialPropertiesTable();
+		if ( !MPT ) continue;
+		for ( const char* prop: {"RINDEX", "ABSLENGTH", "RAYLEIGH"} )
+		{
+			G4MaterialPropertyVector* vec = MPT -> GetProperty(prop);
+			if ( !vec ) continue;
+			key << ";" << prop << "=";
+			for ( std::size_t i = 0; i < vec -> GetVectorLength(); i++ )
+				key << vec -> Energy(i) / eV << ":" << (*vec)[i] << ",";
+		}
+	}
+
+	// Surface between the bar and the lab
+	G4VPhysicalVolume* sciPV = G4PhysicalVolumeStore::GetInstance() -> GetVolume("SciPV", false);
+	G4VPhysicalVolume* labPV = G4PhysicalVolumeStore::GetInstance() -> GetVolume("LabPV", false);
+	G4LogicalBorderSurface* LBS = G4LogicalBorderSurface::GetSurface(sciPV, labPV);
+	const G4OpticalSurface* opS = LBS ? dynamic_cast<const G4OpticalSurface*>(LBS -> GetSurfaceProperty()) : 0;
+	if ( opS )
+		key << ";surface=" << opS -> GetType() << "," << opS -> GetFinish() << "," << opS -> GetModel()
+		    << "," << opS -> GetSigmaAlpha() << "," << opS -> GetPolish();
+
+	return key.str();
+}
+
+G4String OptMap::FileName(const G4String& key, const G4String& kind)
+{
+	// FNV-1a of the key
+	std::uint64_t hash = 14695981039346656037ULL;
+	for ( unsigned char c: key )
+	{
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+
+	std::ostringstream name;
+	name << s_Dir << "/mCP_" << kind << "_" << std::hex << std::setw(16) << std::setfill('0') << hash << ".dat";
+	return name.str();
+}
+
+//////////////////////////////////////////////////
+//   Fast mode
+//////////////////////////////////////////////////
+void OptMap::LoadShared()
+{
+	G4double halfZ = 0.;
+	G4String key = ComputeKey(halfZ);
+
+	// Same bar as the last run: nothing to do
+	if ( sharedMap && sharedMap -> GetKey() == key ) return;
+
+	delete sharedMap;
+	sharedMap = 0;
+
+	G4String fileName = FileName(key);
+	OptMap* map = new OptMap();
+	if ( key.empty() || !map -> Load(fileName, key) )
+	{
+		delete map;
+		G4ExceptionDescription ed;
+		ed << "No optical response map for this geometry (" << fileName << ")." << G4endl
+		   << "Run once with '--optics calib' to make one. Photons are tracked in full until then.";
+		G4Exception("mCP::OptMap", "mCP007", JustWarning, ed);
+		return;
+	}
+
+	G4cout << "mCP: optical response map " << fileName << G4endl;
+	sharedMap = map;
+}
+
+const OptMap* OptMap::GetShared()
+{
+	return sharedMap;
+}
+
+//////////////////////////////////////////////////
+//   Calibration mode
+//////////////////////////////////////////////////
+void OptMap::MergeCalibration(const OptMap& threadMap)
+{
+	if ( !threadMap.IsBooked() ) return;
+
+	G4AutoLock lock(&calibMutex);
+	if ( !calibMap ) calibMap = new OptMap();
+	if ( calibMap -> IsBooked() && calibMap -> GetKey() != threadMap.GetKey() ) calibMap -> Book(threadMap.GetHalfZ(), threadMap.GetKey());
+	calibMap -> Merge(threadMap);
+}
+
+void OptMap::SaveCalibration()
+{
+	G4AutoLock lock(&calibMutex);
+	if ( !calibMap || !calibMap -> IsBooked() ) return;
+
+	// Statistics of earlier calibrations of the same bar are kept.
+	G4String fileName = FileName(calibMap -> GetKey());
+	OptMap previous;
+	if ( previous.Load(fileName, calibMap -> GetKey()) ) calibMap -> Merge(previous);
+
+	if ( calibMap -> Save(fileName) ) G4cout << "mCP: optical response map saved to " << fileName << G4endl;
+	else
+	{
+		G4ExceptionDescription ed;
+		ed << "Failed to write " << fileName << ".";
+		G4Exception("mCP::OptMap", "mCP007", JustWarning, ed);
+	}
+
+	delete calibMap;
+	calibMap = 0;
+}
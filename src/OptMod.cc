@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+//   OptMod.cc
+//
+//   Definitions of OptMod class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4OpticalPhoton.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4EventManager.hh"
+#include "Randomize.hh"
+
+#include "OptMod.hh"
+#include "OptMap.hh"
+#include "EveAct.hh"
+#include "EvePro.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+OptMod::OptMod(const G4String& name, G4Region* region): G4VFastSimulationModel(name, region)
+{
+}
+
+OptMod::~OptMod()
+{
+}
+
+//////////////////////////////////////////////////
+//   Applicability and trigger
+//////////////////////////////////////////////////
+G4bool OptMod::IsApplicable(const G4ParticleDefinition& par)
+{
+	return &par == G4OpticalPhoton::Definition();
+}
+
+G4bool OptMod::ModelTrigger(const G4FastTrack&)
+{
+	// Without a map for this bar, photons are tracked in full.
+	return OptMap::GetShared() != 0;
+}
+
+//////////////////////////////////////////////////
+//   Do it
+//////////////////////////////////////////////////
+void OptMod::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+	const OptMap* map = OptMap::GetShared();
+
+	// Position and direction in the frame of the bar
+	G4ThreeVector pos = fastTrack.GetPrimaryTrackLocalPosition();
+	G4ThreeVector dir = fastTrack.GetPrimaryTrackLocalDirection();
+
+	G4double delay = 0.;
+	G4int end = map -> Sample(pos.z(), dir.z(), G4UniformRand(), G4UniformRand(), delay);
+	EveAct* EA = static_cast<EveAct*>(G4EventManager::GetEventManager() -> GetUserEventAction());
+	if ( EA )
+	{
+		const G4Track* track = fastTrack.GetPrimaryTrack();
+		if ( end != 0 ) EA -> AddDetected(end, track -> GetGlobalTime() + delay, track -> GetWeight());
+		if ( EA -> GetProfile() ) EA -> GetProfile() -> AddPhotonKilled();
+	}
+
+	fastStep.KillPrimaryTrack();
+	fastStep.ProposePrimaryTrackPathLength(0.);
+}
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+//   OutMan.cc
+//
+//   Definitions of OutMan class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+
+#include "G4Threading.hh"
+#include "G4AccumulableManager.hh"
+
+#include "OutMan.hh"
+#include "RunAct.hh"
+
+OutMan::Backend OutMan::s_Backend = OutMan::kRoot;
+G4ThreadLocal OutMan* OutMan::s_Instance = 0;
+
+//////////////////////////////////////////////////
+//   Backend and instance
+//////////////////////////////////////////////////
+void OutMan::SetBackend(Backend backend)
+{
+	s_Backend = backend;
+}
+
+OutMan::Backend OutMan::GetBackend()
+{
+	return s_Backend;
+}
+
+OutMan* OutMan::Instance()
+{
+	if ( !s_Instance ) s_Instance = new OutMan();
+	return s_Instance;
+}
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+OutMan::OutMan()
+{
+	m_AM = G4RootAnalysisManager::Instance();
+	m_CW = 0;
+	if ( s_Backend == kCol ) m_CW = new ColWri();
+
+	// Same binning on every thread, fixed before any geometry exists. Local z
+	// of the bar covers the whole lab.
+	for ( G4int i = 0; i < kNHis; i++ ) m_His[i] = 0;
+	if ( s_Backend == kSummary )
+	{
+		m_His[kHisScint  ] = new HisAcc("nScint"          , 200,     0., 2.e5);
+		m_His[kHisCeren  ] = new HisAcc("nCeren"          , 200,     0., 1.e4);
+		m_His[kHisEdepZ  ] = new HisAcc("edepZ_MeV_vs_mm" , 200, -1000., 1000.);
+		m_His[kHisOriginZ] = new HisAcc("originZ_vs_mm"   , 200, -1000., 1000.);
+		for ( G4int i = 0; i < kNHis; i++ ) G4AccumulableManager::Instance() -> RegisterAccumulable(m_His[i]);
+	}
+}
+
+OutMan::~OutMan()
+{
+	delete m_CW;
+	for ( G4int i = 0; i < kNHis; i++ ) delete m_His[i];
+}
+
+//////////////////////////////////////////////////
+//   Open and close
+//////////////////////////////////////////////////
+void OutMan::Open(const G4String& fileBase)
+{
+	if ( s_Backend == kSummary )
+	{
+		m_SumFile = fileBase + ".sum";
+		return;
+	}
+
+	if ( !m_CW )
+	{
+		m_AM -> OpenFile(fileBase + ".root");
+		return;
+	}
+
+	m_CW -> Close();
+	m_ColFile = fileBase;
+	if ( G4Threading::IsWorkerThread() ) m_ColFile += "_t" + std::to_string(G4Threading::G4GetThreadId());
+	m_ColFile += ".mcpcol";
+}
+
+void OutMan::Close()
+{
+	// Master writes what the accumulable manager merged into its histograms.
+	if ( s_Backend == kSummary )
+	{
+		if ( !G4Threading::IsMasterThread() ) return;
+
+		std::ofstream file(m_SumFile);
+		file << "# mCP summary\n";
+		for ( const auto& meta: RunAct::GetMeta() ) file << "# " << meta.first << " = " << meta.second << "\n";
+		for ( G4int i = 0; i < kNHis; i++ ) m_His[i] -> Write(file);
+		if ( !file )
+		{
+			G4ExceptionDescription ed;
+			ed << "Cannot write " << m_SumFile << ".";
+			G4Exception("mCP::OutMan", "mCP009", JustWarning, ed);
+		}
+		return;
+	}
+
+	if ( !m_CW )
+	{
+		// You must save. Otherwise, file will be just empty.
+		m_AM -> Write();
+		// You must close the file. Otherwise, file will be crahsed.
+		m_AM -> CloseFile();
+		return;
+	}
+
+	m_CW -> Close();
+}
+
+void OutMan::OpenColumnar()
+{
+	// Metadata is in the header of every file, so each file stands alone.
+	if ( !m_CW -> Open(m_ColFile, RunAct::GetColumns(), RunAct::GetMeta()) )
+	{
+		G4ExceptionDescription ed;
+		ed << "Cannot open " << m_ColFile << ".";
+		G4Exception("mCP::OutMan", "mCP009", FatalException, ed);
+	}
+}
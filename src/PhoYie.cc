@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+//   PhoYie.cc
+//
+//   Definitions of PhoYie class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4IonisParamMat.hh"
+#include "G4LossTableManager.hh"
+#include "G4EmSaturation.hh"
+#include "G4Poisson.hh"
+#include "Randomize.hh"
+
+#include "PhoYie.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+PhoYie::PhoYie()
+{
+	m_SciPV = 0;
+	m_Yield = 0.;
+	m_ResScale = 0.;
+	m_Sat = 0;
+}
+
+PhoYie::~PhoYie()
+{
+}
+
+//////////////////////////////////////////////////
+//   Resolve
+//////////////////////////////////////////////////
+void PhoYie::Resolve()
+{
+	m_SciPV = G4PhysicalVolumeStore::GetInstance() -> GetVolume("SciPV", false);
+	m_Yield = 0.;
+	m_ResScale = 0.;
+	m_Sat = 0;
+	m_PhoE.clear();
+	m_RIndex.clear();
+	if ( !m_SciPV ) return;
+
+	const G4Material* mat = m_SciPV -> GetLogicalVolume() -> GetMaterial();
+	G4MaterialPropertiesTable* MPT = mat -> GetMaterialPropertiesTable();
+	if ( !MPT ) return;
+
+	if ( MPT -> ConstPropertyExists("SCINTILLATIONYIELD") ) m_Yield = MPT -> GetConstProperty("SCINTILLATIONYIELD");
+	if ( MPT -> ConstPropertyExists("RESOLUTIONSCALE") ) m_ResScale = MPT -> GetConstProperty("RESOLUTIONSCALE");
+
+	// G4OpticalPhysics gives G4Scintillation the saturation of the loss
+	// table manager, which does nothing without a Birks constant.
+	if ( mat -> GetIonisation() -> GetBirksConstant() > 0. ) m_Sat = G4LossTableManager::Instance() -> EmSaturation();
+
+	G4MaterialPropertyVector* RIndex = MPT -> GetProperty("RINDEX");
+	if ( RIndex )
+	{
+		for ( std::size_t i = 0; i < RIndex -> GetVectorLength(); i++ )
+		{
+			m_PhoE.push_back(RIndex -> Energy(i));
+			m_RIndex.push_back((*RIndex)[i]);
+		}
+	}
+}
+
+//////////////////////////////////////////////////
+//   Scintillation
+//////////////////////////////////////////////////
+G4int PhoYie::SampleScint(const G4Step* step) const
+{
+	// As G4Scintillation::PostStepDoIt()
+	G4double eDep = m_Sat ? m_Sat -> VisibleEnergyDepositionAtAStep(step) : step -> GetTotalEnergyDeposit();
+	G4double mean = m_Yield * eDep;
+
+	G4int n;
+	if ( mean > 10. ) n = G4lrint(G4RandGauss::shoot(mean, m_ResScale * std::sqrt(mean)));
+	else n = G4Poisson(mean);
+
+	return n > 0 ? n : 0;
+}
+
+//////////////////////////////////////////////////
+//   Cerenkov
+//////////////////////////////////////////////////
+G4int PhoYie::SampleCeren(const G4Step* step) const
+{
+	// As G4Cerenkov::PostStepDoIt(): mean beta of the step
+	G4double beta = (step -> GetPreStepPoint() -> GetBeta() + step -> GetPostStepPoint() -> GetBeta()) * 0.5;
+	G4double charge = step -> GetPreStepPoint() -> GetCharge() / eplus;
+	G4double mean = CerenPerLength(beta) * charge * charge * step -> GetStepLength();
+	if ( mean <= 0. ) return 0;
+
+	return G4Poisson(mean);
+}
+
+G4double PhoYie::CerenPerLength(G4double beta) const
+{
+	if ( beta <= 0. ) return 0.;
+	const G4double Rfact = 369.81 / (eV * cm);
+	const G4double betaInv = 1. / beta;
+
+	// Frank-Tamm: integral of 1 - 1/(beta n)^2 over energies where n > 1/beta.
+	// Linear n between table points, 1/n^2 by trapezoid like G4Cerenkov.
+	G4double sum = 0.;
+	for ( std::size_t i = 0; i + 1 < m_PhoE.size(); i++ )
+	{
+		G4double e0 = m_PhoE[i], e1 = m_PhoE[i + 1];
+		G4double n0 = m_RIndex[i], n1 = m_RIndex[i + 1];
+		if ( n0 <= betaInv && n1 <= betaInv ) continue;
+
+		// Cut the part below threshold
+		if ( n0 < betaInv )
+		{
+			e0 += (betaInv - n0) / (n1 - n0) * (e1 - e0);
+			n0 = betaInv;
+		}
+		else if ( n1 < betaInv )
+		{
+			e1 = e0 + (betaInv - n0) / (n1 - n0) * (e1 - e0);
+			n1 = betaInv;
+		}
+
+		sum += (e1 - e0) * (1. - betaInv * betaInv * 0.5 * (1. / (n0 * n0) + 1. / (n1 * n1)));
+	}
+
+	return Rfact * sum;
+}
@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+//   PhyCac.cc
+//
+//   Definitions of PhyCac class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+#include "G4RunManager.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VPhysicsConstructor.hh"
+#include "G4ProductionCuts.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4Material.hh"
+#include "G4Element.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Timer.hh"
+#include "G4Version.hh"
+#include "G4EmParameters.hh"
+#if G4VERSION_NUMBER >= 1110
+#include "G4FindDataDir.hh"
+#endif
+
+#include "PhyCac.hh"
+
+G4String PhyCac::s_Dir = "";
+
+namespace
+{
+	// Name of the file holding the key in an entry
+	const char* keyFile = "mCP_physics.key";
+
+	// Data sets the tables are computed from. Their versions are in the
+	// directory names, e.g. G4EMLOW8.5.
+	const char* dataSets[] = {"G4LEDATA", "G4ENSDFSTATEDATA", "G4LEVELGAMMADATA", "G4PARTICLEXSDATA",
+	                          "G4RADIOACTIVEDATA", "G4NEUTRONHPDATA", "G4REALSURFACEDATA"};
+
+	// FNV-1a
+	std::uint64_t Hash(const std::string& text)
+	{
+		std::uint64_t hash = 14695981039346656037ULL;
+		for ( unsigned char c: text )
+		{
+			hash ^= c;
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+}
+
+//////////////////////////////////////////////////
+//   Configuration
+//////////////////////////////////////////////////
+void PhyCac::Configure(const G4String& dir)
+{
+	s_Dir = dir;
+}
+
+G4bool PhyCac::IsEnabled()
+{
+	return !s_Dir.empty();
+}
+
+//////////////////////////////////////////////////
+//   Build
+//////////////////////////////////////////////////
+G4String PhyCac::Build(G4RunManager* RM, G4VModularPhysicsList* PL, const G4String& optics)
+{
+	G4String key, entry;
+	G4bool hit = false;
+	if ( IsEnabled() )
+	{
+		key = ComputeKey(PL, optics);
+		entry = EntryName(key);
+		hit = Check(entry, key);
+		if ( hit ) PL -> SetPhysicsTableRetrieved(entry);
+	}
+
+	// An empty run builds (or retrieves) the tables and processes no event.
+	G4Timer timer;
+	timer.Start();
+	RM -> BeamOn(0);
+	timer.Stop();
+
+	// Geant4 falls back to building when the stored cuts do not match the
+	// current ones. Then the entry is stale.
+	G4String status = "built";
+	if ( hit && PL -> IsPhysicsTableRetrieved() ) status = "retrieved";
+	else if ( IsEnabled() )
+	{
+		if ( hit )
+		{
+			G4ExceptionDescription ed;
+			ed << "Physics tables in " << entry << " could not be used. They are built and stored again.";
+			G4Exception("mCP::PhyCac", "mCP010", JustWarning, ed);
+			PL -> ResetPhysicsTableRetrieved();
+		}
+		if ( Store(PL, entry, key) ) status = "stored";
+	}
+
+	G4cout << "mCP: physics tables " << status << " in " << timer.GetRealElapsed() << " s";
+	if ( IsEnabled() ) G4cout << " (" << entry << ")";
+	G4cout << G4endl;
+
+	return status;
+}
+
+//////////////////////////////////////////////////
+//   Key
+//////////////////////////////////////////////////
+G4String PhyCac::ComputeKey(G4VModularPhysicsList* PL, const G4String& optics)
+{
+	std::ostringstream key;
+	key << std::setprecision(12);
+	key << "geant4=" << G4VERSION_NUMBER << ";optics=" << optics;
+
+	// Data set versions, from the directory each variable points to
+	for ( const char* name: dataSets )
+	{
+#if G4VERSION_NUMBER >= 1110
+		const char* dir = G4FindDataDir(name);
+#else
+		const char* dir = std::getenv(name);
+#endif
+		std::filesystem::path path(dir ? dir : "");
+		if ( !path.has_filename() ) path = path.parent_path();
+		key << ";" << name << "=" << path.filename().string();
+	}
+
+	// EM options (fluctuations, step functions, MSC model parameters, ...)
+	// change the tables as much as the constructors do. All of them are in
+	// the dump, which is hashed to keep the key short.
+	std::ostringstream emParameters;
+	G4EmParameters::Instance() -> StreamInfo(emParameters);
+	key << ";emParameters=" << std::hex << Hash(emParameters.str()) << std::dec;
+
+	// Physics constructors, in order
+	const G4VPhysicsConstructor* PC = 0;
+	for ( G4int i = 0; (PC = PL -> GetPhysics(i)) != 0; i++ )
+		key << ";physics=" << PC -> GetPhysicsName() << ":" << PC -> GetPhysicsType();
+
+	// Production cuts of every region
+	key << ";defaultCut=" << PL -> GetDefaultCutValue() / mm;
+	for ( const G4Region* region: *G4RegionStore::GetInstance() )
+	{
+		const G4ProductionCuts* cuts = region -> GetProductionCuts();
+		key << ";region=" << region -> GetName();
+		if ( !cuts ) continue;
+		for ( G4double cut: cuts -> GetProductionCuts() ) key << "," << cut / mm;
+	}
+
+	// Materials, with their composition
+	for ( const G4Material* mat: *G4Material::GetMaterialTable() )
+	{
+		key << ";material=" << mat -> GetName() << "," << mat -> GetDensity() / (g / cm3)
+		    << "," << mat -> GetTemperature() / kelvin << "," << mat -> GetPressure() / atmosphere;
+		for ( std::size_t i = 0; i < mat -> GetNumberOfElements(); i++ )
+			key << "," << mat -> GetElement(i) -> GetName() << ":" << mat -> GetFractionVector()[i];
+	}
+
+	return key.str();
+}
+
+G4String PhyCac::EntryName(const G4String& key)
+{
+	std::ostringstream name;
+	name << s_Dir << "/mCP_physics_" << std::hex << std::setw(16) << std::setfill('0') << Hash(key);
+	return name.str();
+}
+
+//////////////////////////////////////////////////
+//   Entries
+//////////////////////////////////////////////////
+G4bool PhyCac::Check(const G4String& entry, const G4String& key)
+{
+	std::ifstream file(entry + "/" + keyFile);
+	if ( !file ) return false;
+
+	std::string stored((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return stored == key;
+}
+
+G4bool PhyCac::Store(G4VModularPhysicsList* PL, const G4String& entry, const G4String& key)
+{
+	// Store in a directory of this process, and move it in place. Jobs of the
+	// farm may be storing the same entry at the same time, and a job reading
+	// it should never see half of it. The key goes in last.
+	namespace fs = std::filesystem;
+	std::error_code ec;
+	G4String tmpName = entry + ".tmp" + std::to_string(getpid());
+	fs::remove_all(tmpName.c_str(), ec);
+	fs::create_directories(tmpName.c_str(), ec);
+	G4bool stored = !ec && PL -> StorePhysicsTable(tmpName);
+	if ( stored )
+	{
+		std::ofstream file(tmpName + "/" + keyFile);
+		file << key;
+		file.close();
+		stored = bool(file);
+	}
+
+	// A stale entry is replaced. If another job has just put a good one in
+	// place, rename fails and that one is kept.
+	if ( stored && !Check(entry, key) ) fs::remove_all(entry.c_str(), ec);
+	if ( stored ) fs::rename(tmpName.c_str(), entry.c_str(), ec);
+	fs::remove_all(tmpName.c_str(), ec);
+	if ( stored && Check(entry, key) ) return true;
+
+	G4ExceptionDescription ed;
+	ed << "Could not store physics tables in " << entry << ".";
+	G4Exception("mCP::PhyCac", "mCP010", JustWarning, ed);
+	return false;
+}
@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////
+//   PhyLis.cc
+//
+//   Definitions of PhyLis class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4SystemOfUnits.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4DecayPhysics.hh"
+
+#include "PhyLis.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+PhyLis::PhyLis(G4bool accurate): G4VModularPhysicsList()
+{
+	// Same production cut as QGSP_BERT, so that only the physics differs
+	SetDefaultCutValue(0.7 * mm);
+
+	if ( accurate ) RegisterPhysics(new G4EmStandardPhysics_option4());
+	else            RegisterPhysics(new G4EmStandardPhysics());
+	RegisterPhysics(new G4DecayPhysics());
+}
+
+PhyLis::~PhyLis()
+{
+}
+
+//////////////////////////////////////////////////
+//   Cuts
+//////////////////////////////////////////////////
+void PhyLis::SetCuts()
+{
+	SetCutsWithDefault();
+}
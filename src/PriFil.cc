@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+//   PriFil.cc
+//
+//   Definitions of PriFil class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4ParticleTable.hh"
+#include "G4IonTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "PriFil.hh"
+
+const char* PriFil::s_Map = 0;
+std::size_t PriFil::s_Size = 0;
+std::uint64_t PriFil::s_NEvents = 0;
+const std::uint64_t* PriFil::s_Index = 0;
+const PriFmt::Record* PriFil::s_Records = 0;
+
+namespace
+{
+	// Pages asked for ahead of a thread, and how close it gets before more
+	const std::size_t PrefetchWindow = 8 << 20;
+	const std::size_t PrefetchMargin = 2 << 20;
+}
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+PriFil::PriFil()
+{
+	m_LastPDG = 0;
+	m_LastPar = 0;
+	m_Fetched = 0;
+}
+
+PriFil::~PriFil()
+{
+}
+
+//////////////////////////////////////////////////
+//   Process-wide file
+//////////////////////////////////////////////////
+G4bool PriFil::Open(const G4String& fileName, G4String& error)
+{
+	Close();
+
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if ( fd < 0 )
+	{
+		error = "cannot open " + fileName;
+		return false;
+	}
+	struct stat st;
+	if ( fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(PriFmt::Header)) )
+	{
+		close(fd);
+		error = fileName + " is not a primary file";
+		return false;
+	}
+	void* map = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if ( map == MAP_FAILED )
+	{
+		error = "cannot map " + fileName;
+		return false;
+	}
+	s_Map = static_cast<const char*>(map);
+	s_Size = st.st_size;
+
+	// Header, and where the index and records are
+	PriFmt::Header header;
+	std::memcpy(&header, s_Map, sizeof(header));
+	std::uint64_t nRecords = (s_Size - sizeof(header)) / sizeof(PriFmt::Record);
+	G4bool ok = std::memcmp(header.magic, PriFmt::Magic, sizeof(PriFmt::Magic)) == 0
+	         && header.nPrimaries <= nRecords
+	         && header.indexPos >= sizeof(header) + header.nPrimaries * sizeof(PriFmt::Record)
+	         && header.indexPos % 8 == 0
+	         && header.nEvents < s_Size / 8
+	         && header.indexPos + (header.nEvents + 1) * 8 <= s_Size;
+	if ( ok )
+	{
+		s_NEvents = header.nEvents;
+		s_Index = reinterpret_cast<const std::uint64_t*>(s_Map + header.indexPos);
+		s_Records = reinterpret_cast<const PriFmt::Record*>(s_Map + sizeof(header));
+		ok = s_Index[s_NEvents] == header.nPrimaries;
+	}
+	if ( !ok )
+	{
+		Close();
+		error = fileName + " is not a primary file, or is truncated";
+		return false;
+	}
+
+	// The index is small and read all over the place. Records are read
+	// roughly in order, and threads ask for them as they go.
+	madvise(const_cast<char*>(s_Map), s_Size, MADV_SEQUENTIAL);
+	return true;
+}
+
+void PriFil::Close()
+{
+	if ( s_Map ) munmap(const_cast<char*>(s_Map), s_Size);
+	s_Map = 0;
+	s_Size = 0;
+	s_NEvents = 0;
+	s_Index = 0;
+	s_Records = 0;
+}
+
+G4bool PriFil::IsEnabled()
+{
+	return s_Map != 0;
+}
+
+std::uint64_t PriFil::GetNEvents()
+{
+	return s_NEvents;
+}
+
+//////////////////////////////////////////////////
+//   Prefetch
+//////////////////////////////////////////////////
+void PriFil::Prefetch(const char* address)
+{
+	// Nothing to do while the window ahead is long enough. Jumping back (a
+	// new run) starts over.
+	if ( address + PrefetchMargin <= m_Fetched && address + PrefetchWindow >= m_Fetched ) return;
+
+	static const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+	std::size_t begin = (address - s_Map) & ~(pageSize - 1);
+	if ( begin >= s_Size ) return;
+	std::size_t length = std::min(PrefetchWindow, s_Size - begin);
+	madvise(const_cast<char*>(s_Map + begin), length, MADV_WILLNEED);
+	m_Fetched = s_Map + begin + length;
+}
+
+//////////////////////////////////////////////////
+//   Particle
+//////////////////////////////////////////////////
+G4ParticleDefinition* PriFil::FindParticle(G4int pdg)
+{
+	if ( pdg == m_LastPDG && m_LastPar ) return m_LastPar;
+
+	// Nuclei are 10LZZZAAAI, and made on demand.
+	G4ParticleDefinition* par = G4ParticleTable::GetParticleTable() -> FindParticle(pdg);
+	if ( !par && pdg > 1000000000 ) par = G4IonTable::GetIonTable() -> GetIon(pdg);
+
+	m_LastPDG = pdg;
+	m_LastPar = par;
+	return par;
+}
+
+//////////////////////////////////////////////////
+//   Generate
+//////////////////////////////////////////////////
+void PriFil::Generate(G4Event* anEvent, std::uint64_t entry)
+{
+	if ( entry >= s_NEvents )
+	{
+		G4ExceptionDescription ed;
+		ed << "Event " << anEvent -> GetEventID() << " asks for entry " << entry << ", but the primary file has "
+		   << s_NEvents << " events.";
+		G4Exception("mCP::PriFil", "mCP013", RunMustBeAborted, ed);
+		return;
+	}
+	std::uint64_t first = s_Index[entry];
+	std::uint64_t last = s_Index[entry + 1];
+	if ( first > last || last > s_Index[s_NEvents] )
+	{
+		G4ExceptionDescription ed;
+		ed << "Index of entry " << entry << " of the primary file is broken.";
+		G4Exception("mCP::PriFil", "mCP013", RunMustBeAborted, ed);
+		return;
+	}
+	Prefetch(reinterpret_cast<const char*>(s_Records + first));
+
+	// Primaries in a row at the same place and time share a vertex.
+	G4PrimaryVertex* vertex = 0;
+	for ( std::uint64_t i = first; i < last; i++ )
+	{
+		const PriFmt::Record& rec = s_Records[i];
+		G4ParticleDefinition* par = FindParticle(rec.pdg);
+		if ( !par )
+		{
+			G4ExceptionDescription ed;
+			ed << "Unknown PDG code " << rec.pdg << " in entry " << entry << " of the primary file. Skipped.";
+			G4Exception("mCP::PriFil", "mCP013", JustWarning, ed);
+			continue;
+		}
+
+		G4ThreeVector pos(rec.x * mm, rec.y * mm, rec.z * mm);
+		G4double time = rec.t * ns;
+		if ( !vertex || vertex -> GetPosition() != pos || vertex -> GetT0() != time )
+		{
+			vertex = new G4PrimaryVertex(pos, time);
+			anEvent -> AddPrimaryVertex(vertex);
+		}
+		vertex -> SetPrimary(new G4PrimaryParticle(par, rec.px * MeV, rec.py * MeV, rec.pz * MeV));
+	}
+}
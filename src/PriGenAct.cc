@@ -14,6 +14,9 @@
 #include "Randomize.hh"
 
 #include "PriGenAct.hh"
+#include "CosGen.hh"
+#include "PriFil.hh"
+#include "RunAct.hh"
 
 //////////////////////////////////////////////////
 //   Constructor and destructor
@@ -44,10 +47,17 @@ PriGenAct::PriGenAct()
 	m_GunPos = G4ThreeVector(m_BeamPX, m_BeamPY, - m_WorldZ / 2.);
 	m_PG -> SetParticlePosition(m_GunPos);
 
+	// '--cosmic': tables are made here, once per thread.
+	m_CG = CosGen::IsEnabled() ? new CosGen() : 0;
+
+	// '--primaries': the file is already mapped by main().
+	m_PF = PriFil::IsEnabled() ? new PriFil() : 0;
 }
 
 PriGenAct::~PriGenAct()
 {
+	delete m_PF;
+	delete m_CG;
 	delete m_PG;
 }
 
@@ -56,5 +66,14 @@ PriGenAct::~PriGenAct()
 //////////////////////////////////////////////////
 void PriGenAct::GeneratePrimaries(G4Event* anEvent)
 {
+	// Entry of the file from the event ID, which is unique in a run, after
+	// the entries of the runs before
+	if ( m_PF )
+	{
+		m_PF -> Generate(anEvent, RunAct::GetEarlierEvents() + anEvent -> GetEventID() + RunAct::GetEventIDOffset());
+		return;
+	}
+
+	if ( m_CG ) m_CG -> Shoot(m_PG);
 	m_PG -> GeneratePrimaryVertex(anEvent);
 }
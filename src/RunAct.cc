@@ -12,14 +12,40 @@
 #include "G4Run.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4RootAnalysisManager.hh"
+#include "G4Threading.hh"
+#include "G4AccumulableManager.hh"
 
 #include "RunAct.hh"
+#include "SteAct.hh"
+#include "SurTab.hh"
+#include "EveAct.hh"
+#include "OptMap.hh"
+#include "OutMan.hh"
+#include "SteCos.hh"
+
+std::vector<std::pair<G4String, char>> RunAct::s_Columns =
+{
+	{"eventID", 'I'}, // Column ID = 0
+	{"nScint" , 'I'}, // Column ID = 1
+	{"nCeren" , 'I'}, // Column ID = 2
+};
+std::vector<std::pair<G4String, G4String>> RunAct::s_Meta;
+G4String RunAct::s_FileBase = "";
+G4int RunAct::s_Shard = -1;
+G4int RunAct::s_EventIDOffset = 0;
+G4int RunAct::s_RunEvents = 0;
+G4long RunAct::s_EarlierEvents = 0;
 
 //////////////////////////////////////////////////
 //   Constructor
 //////////////////////////////////////////////////
-RunAct::RunAct(): G4UserRunAction()
+RunAct::RunAct(SteAct* SA, EveAct* EA): G4UserRunAction(), m_SA(SA), m_EA(EA)
 {
+	// Columnar output needs no booking. Summary histograms of this thread
+	// are registered when its output manager is made.
+	OutMan::Instance();
+	if ( OutMan::GetBackend() != OutMan::kRoot ) return;
+
 	// Create analysis manager
 	auto AM = G4RootAnalysisManager::Instance();
 
@@ -27,12 +53,48 @@ RunAct::RunAct(): G4UserRunAction()
 	// I don't like chatterbox...
 	AM -> SetVerboseLevel(0);
 
+	// In multithreaded mode, worker ntuples are merged into the master file.
+	if ( G4Threading::IsMultithreadedApplication() ) AM -> SetNtupleMerging(true);
+
 	// Creating ntuple
 	AM -> CreateNtuple("mCP", "mCP");
-	AM -> CreateNtupleIColumn("eventID"); // Column ID = 0
-	AM -> CreateNtupleIColumn("nScint" ); // Column ID = 1
-	AM -> CreateNtupleIColumn("nCeren" ); // Column ID = 2
+	for ( const auto& col: GetColumns() )
+	{
+		if ( col.second == 'I' ) AM -> CreateNtupleIColumn(col.first);
+		else                     AM -> CreateNtupleDColumn(col.first);
+	}
 	AM -> FinishNtuple();
+
+	// Metadata ntuple: one row per key
+	AM -> CreateNtuple("mCPmeta", "mCP run metadata");
+	AM -> CreateNtupleSColumn("key"  ); // Column ID = 0
+	AM -> CreateNtupleSColumn("value"); // Column ID = 1
+	AM -> FinishNtuple();
+}
+
+//////////////////////////////////////////////////
+//   Ntuple columns
+//////////////////////////////////////////////////
+const std::vector<std::pair<G4String, char>>& RunAct::GetColumns()
+{
+	return s_Columns;
+}
+
+G4int RunAct::AddColumn(const G4String& name, char type)
+{
+	G4int ID = GetColumnID(name);
+	if ( ID >= 0 ) return ID;
+
+	s_Columns.push_back(std::make_pair(name, type));
+	return s_Columns.size() - 1;
+}
+
+G4int RunAct::GetColumnID(const G4String& name)
+{
+	for ( std::size_t i = 0; i < s_Columns.size(); i++ )
+		if ( s_Columns[i].first == name ) return i;
+
+	return -1;
 }
 
 //////////////////////////////////////////////////
@@ -45,14 +107,14 @@ RunAct::~RunAct()
 //////////////////////////////////////////////////
 //   Begin of run action
 //////////////////////////////////////////////////
-void RunAct::BeginOfRunAction(const G4Run* /*run*/)
+void RunAct::BeginOfRunAction(const G4Run* run)
 {
 	// All actions defined here will be excuted at the beginning of every run.
 	// What is a run? You may type "/run/beamOn [someNumber]".
 	// Whenever you do this, "one run" runs.
 
-	// Get analysis manager
-	auto AM = G4RootAnalysisManager::Instance();
+	// Get output manager
+	auto OM = OutMan::Instance();
 
 	// Get current time to include it to file name
 	// This time info is going to be used to generate output file name.
@@ -65,26 +127,141 @@ void RunAct::BeginOfRunAction(const G4Run* /*run*/)
 	std::string sTime(buffer);
 
 	// Open an output file
-	// The default file name is set in RunAct::RunAct(),
-	// and it can be overwritten in a macro
+	// The extension comes from the output backend.
 	G4String fileName = "mCP_";
 	fileName += sTime;
-	fileName += ".root";
-	G4cout << fileName << G4endl;
 
-	AM -> OpenFile(fileName);
-	G4cout << "Using " << AM -> GetType() << G4endl;
+	// Sharded job: every shard has its own file and its own event IDs
+	if ( s_Shard >= 0 )
+	{
+		fileName = s_FileBase + "_r" + std::to_string(run -> GetRunID()) + "_s" + std::to_string(s_Shard);
+	}
+	else if ( IsMaster() ) s_RunEvents = run -> GetNumberOfEventToBeProcessed();
+
+	// Workers call this too. ROOT rows end up in the master file, columnar
+	// rows in a file per worker.
+	OM -> Open(fileName);
+	if ( IsMaster() )
+	{
+		if ( OutMan::GetBackend() == OutMan::kRoot )
+		{
+			G4cout << fileName << ".root" << G4endl;
+			G4cout << "Using " << G4RootAnalysisManager::Instance() -> GetType() << G4endl;
+
+			// Once per file. Columnar files have it in their header.
+			FillMeta();
+		}
+		else if ( OutMan::GetBackend() == OutMan::kCol ) G4cout << fileName << "*.mcpcol" << G4endl;
+		else G4cout << fileName << ".sum" << G4endl;
+
+		// '--optics fast': the map of the bar as it is now. It is looked up
+		// again every run, because the geometry may have changed in between.
+		if ( OptMap::GetMode() == OptMap::kFast ) OptMap::LoadShared();
+
+		// '--optics trace': the same for the surface table
+		if ( OptMap::GetMode() == OptMap::kTrace ) SurTab::LoadShared();
+	}
+
+	// Resolve stepping filter and start the clock
+	if ( m_SA ) m_SA -> BeginOfRun();
+	if ( m_EA ) m_EA -> ResetSummary();
+	G4AccumulableManager::Instance() -> Reset();
+	m_Timer.Start();
 }
 
 //////////////////////////////////////////////////
 //   End of run action
 //////////////////////////////////////////////////
-void RunAct::EndOfRunAction(const G4Run* /*run*/)
+void RunAct::EndOfRunAction(const G4Run* run)
 {
+	// Throughput of this thread
+	m_Timer.Stop();
+	G4double realTime = m_Timer.GetRealElapsed();
+	G4int nEvents = run -> GetNumberOfEvent();
+	if ( m_SA && nEvents > 0 && realTime > 0. )
+	{
+		G4long nSteps = m_SA -> GetNSteps();
+		G4cout << "mCP: " << nEvents << " events, " << nSteps << " steps in " << realTime << " s ("
+		       << nEvents / realTime << " events/s, " << 1000. * realTime / nEvents << " ms/event, "
+		       << nSteps / realTime << " steps/s)" << G4endl;
+	}
+	if ( m_EA ) m_EA -> PrintSummary();
+
+	// '--optics calib': threads hand their maps over, and master saves.
+	// '--cost': same, and master prints.
+	if ( m_SA ) m_SA -> EndOfRun();
+	if ( IsMaster() && OptMap::GetMode() == OptMap::kCalib )
+	{
+		OptMap::SaveCalibration();
+		SurTab::SaveCalibration();
+	}
+	if ( IsMaster() ) SteCos::PrintRun();
+	if ( IsMaster() ) s_EarlierEvents += s_RunEvents;
+
+	// Summary histograms: each worker adds its own to master's, and master
+	// (whose EndOfRunAction comes after every worker's) writes them.
+	G4AccumulableManager::Instance() -> Merge();
+
 	// save histograms & ntuple
+	OutMan::Instance() -> Close();
+}
+
+G4double RunAct::GetRealTime() const
+{
+	return m_Timer.GetRealElapsed();
+}
+
+//////////////////////////////////////////////////
+//   Run metadata
+//////////////////////////////////////////////////
+void RunAct::AddMeta(const G4String& key, const G4String& value)
+{
+	for ( auto& meta: s_Meta )
+	{
+		if ( meta.first != key ) continue;
+		meta.second = value;
+		return;
+	}
+	s_Meta.push_back(std::make_pair(key, value));
+}
+
+const std::vector<std::pair<G4String, G4String>>& RunAct::GetMeta()
+{
+	return s_Meta;
+}
+
+void RunAct::FillMeta()
+{
 	auto AM = G4RootAnalysisManager::Instance();
-	// You must save. Otherwise, file will be just empty.
-	AM -> Write();
-	// You must close the file. Otherwise, file will be crahsed.
-	AM -> CloseFile();
+	for ( const auto& meta: s_Meta )
+	{
+		AM -> FillNtupleSColumn(1, 0, meta.first);
+		AM -> FillNtupleSColumn(1, 1, meta.second);
+		AM -> AddNtupleRow(1);
+	}
+}
+
+//////////////////////////////////////////////////
+//   Sharded job
+//////////////////////////////////////////////////
+void RunAct::SetShard(const G4String& fileBase, G4int shard)
+{
+	s_FileBase = fileBase;
+	s_Shard = shard;
+}
+
+void RunAct::SetShardRun(G4int offset, G4int runEvents)
+{
+	s_EventIDOffset = offset;
+	s_RunEvents = runEvents;
+}
+
+G4int RunAct::GetEventIDOffset()
+{
+	return s_EventIDOffset;
+}
+
+G4long RunAct::GetEarlierEvents()
+{
+	return s_EarlierEvents;
 }
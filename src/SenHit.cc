@@ -0,0 +1,11 @@
+////////////////////////////////////////////////////////////////////////////////
+//   SenHit.cc
+//
+//   Pool of SenHit class, one per thread.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SenHit.hh"
+
+G4ThreadLocal G4Allocator<SenHit>* SenHitAllocator = 0;
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+//   SenSD.cc
+//
+//   Definitions of SenSD class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
+#include "G4VProcess.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "SenSD.hh"
+
+G4bool SenSD::s_Enabled = false;
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+SenSD::SenSD(const G4String& name, const G4String& HCName): G4VSensitiveDetector(name)
+{
+	collectionName.insert(HCName);
+	m_HC = 0;
+	m_HCID = -1;
+	m_Capacity = 0;
+	m_OptPho = G4OpticalPhoton::Definition();
+}
+
+SenSD::~SenSD()
+{
+}
+
+//////////////////////////////////////////////////
+//   Event
+//////////////////////////////////////////////////
+void SenSD::Initialize(G4HCofThisEvent* HCE)
+{
+	// The event deletes its collections, so a new one every event: the
+	// collection itself comes from Geant4's pool, but its vector and the
+	// reserved array are two allocations per event, whatever the number of
+	// hits. Reserving the largest size seen keeps it at two.
+	m_HC = new SenHitsCollection(SensitiveDetectorName, collectionName[0]);
+	m_HC -> GetVector() -> reserve(m_Capacity);
+	if ( m_HCID < 0 ) m_HCID = G4SDManager::GetSDMpointer() -> GetCollectionID(m_HC);
+	HCE -> AddHitsCollection(m_HCID, m_HC);
+}
+
+void SenSD::EndOfEvent(G4HCofThisEvent*)
+{
+	m_Capacity = std::max(m_Capacity, m_HC -> GetSize());
+}
+
+//////////////////////////////////////////////////
+//   Process hits
+//////////////////////////////////////////////////
+G4bool SenSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+	G4Track* track = step -> GetTrack();
+	if ( track -> GetDefinition() != m_OptPho ) return false;
+
+	// Photons are absorbed at their first step in a sensor, where they come in.
+	const G4StepPoint* prePoint = step -> GetPreStepPoint();
+	G4int end = prePoint -> GetTouchable() -> GetCopyNumber() == 0 ? +1 : -1;
+	G4double energy = track -> GetTotalEnergy();
+	G4float waveLength = energy > 0. ? h_Planck * c_light / energy / nm : 0.;
+	const G4VProcess* creProc = track -> GetCreatorProcess();
+	G4int creator = creProc ? creProc -> GetProcessSubType() : -1;
+
+	m_HC -> insert(new SenHit(end, prePoint -> GetGlobalTime(), prePoint -> GetPosition(), waveLength, creator, track -> GetWeight()));
+	track -> SetTrackStatus(fStopAndKill);
+
+	return true;
+}
+
+//////////////////////////////////////////////////
+//   Configuration
+//////////////////////////////////////////////////
+void SenSD::Enable()
+{
+	s_Enabled = true;
+}
+
+G4bool SenSD::IsEnabled()
+{
+	return s_Enabled;
+}
+
+//////////////////////////////////////////////////
+//   Hits of an event
+//////////////////////////////////////////////////
+const SenHitsCollection* SenSD::GetHits(const G4Event* event)
+{
+	if ( !s_Enabled ) return 0;
+
+	// Looked up once per thread
+	static G4ThreadLocal G4int HCID = -1;
+	if ( HCID < 0 ) HCID = G4SDManager::GetSDMpointer() -> GetCollectionID("SenSD/SenHC");
+
+	G4HCofThisEvent* HCE = event -> GetHCofThisEvent();
+	if ( !HCE || HCID < 0 ) return 0;
+	return static_cast<const SenHitsCollection*>(HCE -> GetHC(HCID));
+}
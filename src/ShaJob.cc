@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////
+//   ShaJob.cc
+//
+//   Definitions of ShaJob class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+#include "G4RunManager.hh"
+#include "G4RootAnalysisManager.hh"
+#include "G4RootAnalysisReader.hh"
+#include "Randomize.hh"
+
+#include "ShaJob.hh"
+#include "ShaMes.hh"
+#include "RunAct.hh"
+#include "OutMan.hh"
+
+//////////////////////////////////////////////////
+//   Fork
+//////////////////////////////////////////////////
+G4int ShaJob::Fork(G4int nShards, G4long masterSeed)
+{
+	// Build physics tables before forking. Otherwise every child builds its
+	// own at the first /run/beamOn, which is what we want to avoid.
+	G4RunManager::GetRunManager() -> BeamOn(0);
+
+	// Same base name for all shards. PID keeps jobs started in the same
+	// second apart.
+	time_t rawTime;
+	char buffer[80];
+	time(&rawTime);
+	strftime(buffer, sizeof(buffer), "%Y-%m-%d_%H-%M-%S", localtime(&rawTime));
+	G4String fileBase = "mCP_";
+	fileBase += buffer;
+	fileBase += "_" + std::to_string(getpid());
+
+	G4cout << "mCP: forking " << nShards << " shards, master seed " << masterSeed << G4endl;
+	G4cout.flush();
+	fflush(stdout);
+
+	std::vector<pid_t> children;
+	for ( G4int shard = 0; shard < nShards; shard++ )
+	{
+		pid_t pid = fork();
+		if ( pid == 0 )
+		{
+			// Child
+			G4long seed = DeriveSeed(masterSeed, shard);
+			G4Random::setTheSeed(seed);
+			RunAct::SetShard(fileBase, shard);
+			// Lives as long as the process, as the run manager's own messengers
+			new ShaMes(shard, nShards);
+			RunAct::AddMeta("rngSeed", std::to_string(seed));
+			RunAct::AddMeta("rngMasterSeed", std::to_string(masterSeed));
+			RunAct::AddMeta("shard", std::to_string(shard) + "/" + std::to_string(nShards));
+			G4cout << "mCP: shard " << shard << " (pid " << getpid() << ") seed " << seed << G4endl;
+			return shard;
+		}
+		if ( pid < 0 )
+		{
+			G4ExceptionDescription ed;
+			ed << "Failed to fork shard " << shard << ". " << children.size() << " shards are running.";
+			G4Exception("mCP::ShaJob", "mCP005", JustWarning, ed);
+			break;
+		}
+		children.push_back(pid);
+	}
+
+	// Parent: wait for everyone
+	G4int nFailed = nShards - children.size();
+	for ( pid_t pid: children )
+	{
+		int status = 0;
+		if ( waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 )
+		{
+			G4ExceptionDescription ed;
+			ed << "Shard process " << pid << " did not finish cleanly.";
+			G4Exception("mCP::ShaJob", "mCP005", JustWarning, ed);
+			nFailed++;
+		}
+	}
+
+	RunAct::AddMeta("rngMasterSeed", std::to_string(masterSeed));
+	RunAct::AddMeta("shards", std::to_string(nShards));
+	// Columnar files need no merging: the reader takes any number of them.
+	if ( OutMan::GetBackend() == OutMan::kRoot && !Merge(fileBase, nShards) ) nFailed++;
+
+	return nFailed == 0 ? -1 : -2;
+}
+
+//////////////////////////////////////////////////
+//   Derive seed
+//////////////////////////////////////////////////
+G4long ShaJob::DeriveSeed(G4long masterSeed, G4int shard)
+{
+	// SplitMix64 of (master seed, shard). Neighbouring shards get unrelated
+	// seeds, and the same master seed always gives the same shard seeds.
+	std::uint64_t z = static_cast<std::uint64_t>(masterSeed) + 0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(shard + 1);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z =  z ^ (z >> 31);
+
+	// CLHEP engines want a positive 32-bit seed
+	return static_cast<G4long>(z & 0x7FFFFFFF);
+}
+
+//////////////////////////////////////////////////
+//   Merge
+//////////////////////////////////////////////////
+G4bool ShaJob::Merge(const G4String& fileBase, G4int nShards)
+{
+	auto AM = G4RootAnalysisManager::Instance();
+	auto AR = G4RootAnalysisReader::Instance();
+	AR -> SetVerboseLevel(0);
+
+	// Column buffers. Readers keep references to them, so no reallocation.
+	const auto& columns = RunAct::GetColumns();
+	std::vector<G4int> iValues(columns.size(), 0);
+	std::vector<G4double> dValues(columns.size(), 0.);
+
+	G4bool ok = true;
+	for ( G4int runID = 0; ; runID++ )
+	{
+		// Shard files of this run
+		std::vector<G4String> shardFiles;
+		for ( G4int shard = 0; shard < nShards; shard++ )
+		{
+			G4String shardFile = fileBase + "_r" + std::to_string(runID) + "_s" + std::to_string(shard) + ".root";
+			if ( std::ifstream(shardFile).good() ) shardFiles.push_back(shardFile);
+		}
+		if ( shardFiles.empty() ) break;
+		if ( (G4int) shardFiles.size() != nShards )
+		{
+			G4ExceptionDescription ed;
+			ed << "Run " << runID << ": only " << shardFiles.size() << " of " << nShards << " shard files found.";
+			G4Exception("mCP::ShaJob", "mCP005", JustWarning, ed);
+			ok = false;
+		}
+
+		G4String mergedFile = fileBase + "_r" + std::to_string(runID) + ".root";
+		AM -> OpenFile(mergedFile);
+
+		G4long nRows = 0;
+		for ( const auto& shardFile: shardFiles )
+		{
+			G4int ntupleID = AR -> GetNtuple("mCP", shardFile, "", true);
+			if ( ntupleID < 0 )
+			{
+				G4ExceptionDescription ed;
+				ed << "No mCP ntuple in " << shardFile << ". Skipped.";
+				G4Exception("mCP::ShaJob", "mCP005", JustWarning, ed);
+				ok = false;
+				continue;
+			}
+
+			for ( std::size_t i = 0; i < columns.size(); i++ )
+			{
+				if ( columns[i].second == 'I' ) AR -> SetNtupleIColumn(ntupleID, columns[i].first, iValues[i]);
+				else                            AR -> SetNtupleDColumn(ntupleID, columns[i].first, dValues[i]);
+			}
+
+			while ( AR -> GetNtupleRow(ntupleID) )
+			{
+				for ( std::size_t i = 0; i < columns.size(); i++ )
+				{
+					if ( columns[i].second == 'I' ) AM -> FillNtupleIColumn(i, iValues[i]);
+					else                            AM -> FillNtupleDColumn(i, dValues[i]);
+				}
+				AM -> AddNtupleRow();
+				nRows++;
+			}
+		}
+
+		RunAct::FillMeta();
+		AM -> Write();
+		AM -> CloseFile();
+		G4cout << "mCP: merged " << shardFiles.size() << " shards, " << nRows << " events into " << mergedFile << G4endl;
+	}
+
+	return ok;
+}
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//   ShaMes.cc
+//
+//   Definitions of ShaMes class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <sstream>
+
+#include "G4UImanager.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4RunManager.hh"
+
+#include "ShaMes.hh"
+#include "RunAct.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+ShaMes::ShaMes(G4int shard, G4int nShards): G4UImessenger(), m_Shard(shard), m_NShards(nShards)
+{
+	// Geant4's own command goes away first, as a path can have one command
+	// only. Same parameters as that one.
+	G4UImanager* UI = G4UImanager::GetUIpointer();
+	G4UIcommand* original = UI -> GetTree() -> FindPath("/run/beamOn");
+	if ( original ) UI -> RemoveCommand(original);
+
+	m_BeamOnCmd = new G4UIcommand("/run/beamOn", this);
+	m_BeamOnCmd -> SetGuidance("Start a run. In a sharded job, this shard runs its share of the events.");
+	G4UIparameter* nEventsPar = new G4UIparameter("numberOfEvent", 'i', true);
+	nEventsPar -> SetDefaultValue(1);
+	nEventsPar -> SetParameterRange("numberOfEvent >= 0");
+	m_BeamOnCmd -> SetParameter(nEventsPar);
+	G4UIparameter* macroPar = new G4UIparameter("macroFile", 's', true);
+	macroPar -> SetDefaultValue("***NULL***");
+	m_BeamOnCmd -> SetParameter(macroPar);
+	G4UIparameter* nSelectPar = new G4UIparameter("nSelect", 'i', true);
+	nSelectPar -> SetDefaultValue(-1);
+	m_BeamOnCmd -> SetParameter(nSelectPar);
+	m_BeamOnCmd -> AvailableForStates(G4State_Idle);
+}
+
+ShaMes::~ShaMes()
+{
+	delete m_BeamOnCmd;
+}
+
+//////////////////////////////////////////////////
+//   Share of a run
+//////////////////////////////////////////////////
+G4int ShaMes::GetShare(G4int nEvents, G4int shard, G4int nShards)
+{
+	return nEvents / nShards + ( shard < nEvents % nShards ? 1 : 0 );
+}
+
+G4int ShaMes::GetOffset(G4int nEvents, G4int shard, G4int nShards)
+{
+	return shard * (nEvents / nShards) + std::min(shard, nEvents % nShards);
+}
+
+//////////////////////////////////////////////////
+//   Set new value
+//////////////////////////////////////////////////
+void ShaMes::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+	if ( command != m_BeamOnCmd ) return;
+
+	G4int nEvents = 0, nSelect = -1;
+	G4String macroFile;
+	std::istringstream iss(newValue);
+	iss >> nEvents >> macroFile >> nSelect;
+
+	RunAct::SetShardRun(GetOffset(nEvents, m_Shard, m_NShards), nEvents);
+	G4int share = GetShare(nEvents, m_Shard, m_NShards);
+	G4cout << "mCP: shard " << m_Shard << " runs " << share << " of " << nEvents << " events" << G4endl;
+
+	G4RunManager* RM = G4RunManager::GetRunManager();
+	if ( macroFile == "***NULL***" ) RM -> BeamOn(share);
+	else                             RM -> BeamOn(share, macroFile, nSelect);
+}
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+//   StaAct.cc
+//
+//   Definitions of StaAct class's member functions. Details of user
+// actions are here.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4EmProcessSubType.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4StackManager.hh"
+#include "Randomize.hh"
+
+#include "StaAct.hh"
+#include "StaMes.hh"
+#include "EvePro.hh"
+#include "RunAct.hh"
+#include "BoxTra.hh"
+
+G4double StaAct::s_Keep = 1.;
+G4bool StaAct::s_Thinning = false;
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+StaAct::StaAct(EveAct* EA): G4UserStackingAction(), m_EA(EA)
+{
+	m_CountOnly = false;
+	m_ShipPhotons = false;
+	m_BT = 0;
+	m_Keep = s_Keep;
+	m_OptPho = G4OpticalPhoton::Definition();
+	m_SciPV = 0;
+	m_Pro = EA -> GetProfile();
+
+	m_SM = new StaMes(this);
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+StaAct::~StaAct()
+{
+	delete m_SM;
+}
+
+//////////////////////////////////////////////////
+//   Classify new track
+//////////////////////////////////////////////////
+G4ClassificationOfNewTrack StaAct::ClassifyNewTrack(const G4Track* track)
+{
+	// Profile: this track is about to join the urgent stack.
+	if ( m_Pro )
+	{
+		m_Pro -> AddStackDepth(stackManager -> GetNUrgentTrack() + 1);
+		if ( track -> GetDefinition() == m_OptPho ) m_Pro -> AddPhotonMade();
+	}
+
+	// Only optical photons are of interest. Everything else is tracked as usual.
+	if ( track -> GetDefinition() != m_OptPho ) return fUrgent;
+
+	// Full tracking: SteAct does the counting.
+	if ( !m_CountOnly )
+	{
+		// Acceptance filter: this photon would hardly reach an end.
+		if ( track -> GetWeight() == 0. ) return CountAndKill(track);
+
+		// Thinning: a kept photon stands for 1/p photons.
+		if ( m_Keep < 1. )
+		{
+			if ( G4UniformRand() >= m_Keep ) return CountAndKill(track);
+			G4Track* keptTrack = const_cast<G4Track*>(track);
+			keptTrack -> SetWeight(track -> GetWeight() / m_Keep);
+		}
+
+		// Trace mode: the box tracer takes photons made in the bar.
+		if ( m_BT && m_BT -> IsReady() && track -> GetVolume() == m_SciPV )
+		{
+			m_BT -> Add(track);
+			return CountAndKill(track);
+		}
+
+#if G4VERSION_NUMBER >= 1130
+		// The muon and its charged secondaries stay on this thread, while
+		// photons are handed out to other workers in batches.
+		if ( m_ShipPhotons ) return fSubEvent_0;
+#endif
+		return fUrgent;
+	}
+
+	return CountAndKill(track);
+}
+
+G4ClassificationOfNewTrack StaAct::CountAndKill(const G4Track* track)
+{
+	// Scintillation and Cerenkov hand the pre-step touchable of the parent
+	// to their secondaries, so the volume is already known here.
+	if ( track -> GetVolume() == m_SciPV )
+	{
+		const G4VProcess* creProc = track -> GetCreatorProcess();
+		if ( creProc )
+		{
+			G4int subType = creProc -> GetProcessSubType();
+			if      ( subType == fScintillation ) m_EA -> AddScint();
+			else if ( subType == fCerenkov      ) m_EA -> AddCeren();
+		}
+	}
+
+	// The photon is never tracked.
+	if ( m_Pro ) m_Pro -> AddPhotonKilled();
+	return fKill;
+}
+
+//////////////////////////////////////////////////
+//   Prepare new event
+//////////////////////////////////////////////////
+void StaAct::PrepareNewEvent()
+{
+	// Geometry can be rebuilt between runs, so the volume is looked up again.
+	m_SciPV = G4PhysicalVolumeStore::GetInstance() -> GetVolume("SciPV", false);
+	if ( m_BT ) m_BT -> Clear();
+}
+
+//////////////////////////////////////////////////
+//   New stage
+//////////////////////////////////////////////////
+void StaAct::NewStage()
+{
+	// The stack is empty: photons held by the box tracer are traced now, so
+	// their arrivals are in before the end of the event.
+	if ( m_BT ) m_BT -> Flush();
+}
+
+//////////////////////////////////////////////////
+//   Counting mode
+//////////////////////////////////////////////////
+void StaAct::SetCountOnly(G4bool countOnly)
+{
+	m_CountOnly = countOnly;
+}
+
+G4bool StaAct::GetCountOnly() const
+{
+	return m_CountOnly;
+}
+
+//////////////////////////////////////////////////
+//   Thinning
+//////////////////////////////////////////////////
+void StaAct::EnableThinning(G4double keep)
+{
+	s_Keep = keep;
+	s_Thinning = true;
+
+	// Weighted counts, then their thinning variance. EveAct relies on this
+	// order, see EveAct::Weighted.
+	const char* names[4] = {"Scint", "Ceren", "EndPz", "EndMz"};
+	for ( const char* name: names ) RunAct::AddColumn(G4String("w") + name, 'D');
+	for ( const char* name: names ) RunAct::AddColumn(G4String("v") + name, 'D');
+}
+
+void StaAct::SetKeepProbability(G4double keep)
+{
+	// Without the weighted columns, kept photons would be counted as one.
+	if ( !s_Thinning && keep < 1. )
+	{
+		G4Exception("mCP::StaAct", "mCP014", JustWarning, "Thinning needs '--thin'. Ignored.");
+		return;
+	}
+	m_Keep = keep;
+}
+
+G4double StaAct::GetKeepProbability() const
+{
+	return m_Keep;
+}
+
+//////////////////////////////////////////////////
+//   Sub-event parallel mode
+//////////////////////////////////////////////////
+void StaAct::SetShipPhotons(G4bool shipPhotons)
+{
+	m_ShipPhotons = shipPhotons;
+}
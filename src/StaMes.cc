@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+//   StaMes.cc
+//
+//   Definitions of StaMes class's member functions. Macro commands for the
+// stacking action live under /mCP/stack/.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+
+#include "StaMes.hh"
+#include "StaAct.hh"
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+StaMes::StaMes(StaAct* SA): G4UImessenger(), m_SA(SA)
+{
+	m_Dir = new G4UIdirectory("/mCP/");
+	m_Dir -> SetGuidance("mCP specific controls.");
+
+	m_StaDir = new G4UIdirectory("/mCP/stack/");
+	m_StaDir -> SetGuidance("Stacking action controls.");
+
+	m_CountOnlyCmd = new G4UIcmdWithABool("/mCP/stack/countOnly", this);
+	m_CountOnlyCmd -> SetGuidance("Count optical photons at creation and kill them before tracking.");
+	m_CountOnlyCmd -> SetGuidance("nScint and nCeren are filled as usual, but no photon is tracked.");
+	m_CountOnlyCmd -> SetParameterName("countOnly", true);
+	m_CountOnlyCmd -> SetDefaultValue(true);
+	m_CountOnlyCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_KeepCmd = new G4UIcmdWithADouble("/mCP/stack/keepProbability", this);
+	m_KeepCmd -> SetGuidance("Probability to keep and track an optical photon ('--thin').");
+	m_KeepCmd -> SetGuidance("Kept photons have the weight 1/p. 1 tracks every photon.");
+	m_KeepCmd -> SetParameterName("p", false);
+	m_KeepCmd -> SetRange("p > 0. && p <= 1.");
+	m_KeepCmd -> AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+StaMes::~StaMes()
+{
+	delete m_KeepCmd;
+	delete m_CountOnlyCmd;
+	delete m_StaDir;
+	delete m_Dir;
+}
+
+//////////////////////////////////////////////////
+//   Set new value
+//////////////////////////////////////////////////
+void StaMes::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+	if ( command == m_CountOnlyCmd )
+		m_SA -> SetCountOnly(m_CountOnlyCmd -> GetNewBoolValue(newValue));
+	else if ( command == m_KeepCmd )
+		m_SA -> SetKeepProbability(m_KeepCmd -> GetNewDoubleValue(newValue));
+}
+
+//////////////////////////////////////////////////
+//   Get current value
+//////////////////////////////////////////////////
+G4String StaMes::GetCurrentValue(G4UIcommand* command)
+{
+	if ( command == m_CountOnlyCmd )
+		return m_CountOnlyCmd -> ConvertToString(m_SA -> GetCountOnly());
+	if ( command == m_KeepCmd )
+		return m_KeepCmd -> ConvertToString(m_SA -> GetKeepProbability());
+
+	return "";
+}
@@ -7,7 +7,11 @@
 //                       - 18. Dec. 2023. Hoyong Jeong (hoyong5419@korea.ac.kr)
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+
 #include "SteAct.hh"
+#include "OutMan.hh"
+#include "EvePro.hh"
 
 #include "G4String.hh"
 #include "G4VPhysicalVolume.hh"
@@ -17,12 +21,49 @@
 #include "G4RootAnalysisManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4RunManager.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Box.hh"
 
 //////////////////////////////////////////////////
 //   Constructor
 //////////////////////////////////////////////////
 SteAct::SteAct(EveAct* EA): G4UserSteppingAction(), m_EA(EA)
 {
+	m_SF = new SteFil();
+
+	m_Legacy = false;
+	m_NSteps = 0;
+	m_Pro = EA -> GetProfile();
+	m_Cos = SteCos::IsEnabled() ? new SteCos() : 0;
+
+	m_Cal = 0;
+	m_Sur = 0;
+	if ( OptMap::GetMode() == OptMap::kCalib )
+	{
+		m_Cal = new OptMap();
+		m_Sur = new SurTab();
+	}
+	m_SciHalf[0] = m_SciHalf[1] = 0.;
+	m_SciPV = 0;
+	m_OptPhoton = G4OpticalPhoton::Definition();
+
+	m_PY = 0;
+	if ( OptMap::GetMode() == OptMap::kYield ) m_PY = new PhoYie();
+
+	m_AF = 0;
+	if ( AccFil::GetMode() != AccFil::kOff ) m_AF = new AccFil(EA);
+
+	m_BT = 0;
+	if ( OptMap::GetMode() == OptMap::kTrace ) m_BT = new BoxTra(EA);
+
+	// Summary mode only
+	m_HisEdepZ = OutMan::Instance() -> GetHis(OutMan::kHisEdepZ);
+	m_HisOriginZ = OutMan::Instance() -> GetHis(OutMan::kHisOriginZ);
 }
 
 //////////////////////////////////////////////////
@@ -30,12 +71,197 @@ SteAct::SteAct(EveAct* EA): G4UserSteppingAction(), m_EA(EA)
 //////////////////////////////////////////////////
 SteAct::~SteAct()
 {
+	delete m_SF;
+	delete m_Cal;
+	delete m_Sur;
+	delete m_PY;
+	delete m_Cos;
+	delete m_AF;
+	delete m_BT;
+}
+
+//////////////////////////////////////////////////
+//   Begin of run
+//////////////////////////////////////////////////
+void SteAct::BeginOfRun()
+{
+	// Every name lookup happens here, not in the step loop.
+	m_SF -> Resolve();
+	m_Legacy = m_SF -> GetLegacy();
+	m_NSteps = 0;
+	if ( m_PY ) m_PY -> Resolve();
+	m_SciPV = G4PhysicalVolumeStore::GetInstance() -> GetVolume("SciPV", false);
+	if ( m_Cos ) m_Cos -> Reset();
+	if ( m_AF ) m_AF -> BeginOfRun();
+	if ( m_BT ) m_BT -> BeginOfRun();
+
+	// Calibration follows every photon to the end of the bar, so the filter
+	// must not kill it on the way.
+	if ( m_Cal )
+	{
+		m_SF -> SetKill(false);
+		G4double halfZ = 0.;
+		G4String key = OptMap::ComputeKey(halfZ);
+		m_Cal -> Book(halfZ, key);
+		m_Sur -> Book(key);
+
+		const G4Box* box = m_SciPV ? dynamic_cast<const G4Box*>(m_SciPV -> GetLogicalVolume() -> GetSolid()) : 0;
+		m_SciHalf[0] = box ? box -> GetXHalfLength() : 0.;
+		m_SciHalf[1] = box ? box -> GetYHalfLength() : 0.;
+	}
+}
+
+//////////////////////////////////////////////////
+//   End of run
+//////////////////////////////////////////////////
+void SteAct::EndOfRun()
+{
+	if ( m_Cal ) OptMap::MergeCalibration(*m_Cal);
+	if ( m_Sur ) SurTab::MergeCalibration(*m_Sur);
+	if ( m_BT ) m_BT -> EndOfRun();
+	if ( m_Cos ) m_Cos -> MergeRun();
+}
+
+G4long SteAct::GetNSteps() const
+{
+	return m_NSteps;
 }
 
 //////////////////////////////////////////////////
 //   User stepping action
 //////////////////////////////////////////////////
 void SteAct::UserSteppingAction(const G4Step* step)
+{
+	m_NSteps++;
+	if ( m_Cos ) m_Cos -> AddStep(step);
+	if ( m_Pro ) m_Pro -> AddStep(step -> GetTrack() -> GetDefinition());
+
+	if ( m_Legacy )
+	{
+		LegacySteppingAction(step);
+		return;
+	}
+
+	// No photon in yield mode. Count what would have been made.
+	if ( m_PY )
+	{
+		G4int nScint, nCeren;
+		m_PY -> Sample(step, nScint, nCeren);
+		if ( nScint ) m_EA -> AddScint(nScint);
+		if ( nCeren ) m_EA -> AddCeren(nCeren);
+		if ( m_HisEdepZ ) FillSummary(step, nScint + nCeren);
+		return;
+	}
+
+	// Photons made in this step, before any of them is stacked
+	if ( m_AF ) m_AF -> Filter(step);
+
+	// Are you what we are looking for?
+	SteFil::Result res = m_SF -> Match(step);
+	if ( res == SteFil::kScint )
+	{
+		m_EA -> AddScint();
+		m_EA -> AddWeighted(EveAct::kWScint, step -> GetTrack() -> GetWeight());
+	}
+	else if ( res == SteFil::kCeren )
+	{
+		m_EA -> AddCeren();
+		m_EA -> AddWeighted(EveAct::kWCeren, step -> GetTrack() -> GetWeight());
+	}
+
+	// Summary mode: photons are counted at their origin
+	if ( m_HisEdepZ ) FillSummary(step, res == SteFil::kNoMatch ? 0 : -1);
+
+	if ( m_Cal )
+	{
+		Calibrate(step);
+		return;
+	}
+	if ( res == SteFil::kNoMatch ) return;
+
+	// Once the optical photon is arrested, its step is killed.
+	if ( m_SF -> GetKill() )
+	{
+		step -> GetTrack() -> SetTrackStatus(fStopAndKill);
+		if ( m_Pro ) m_Pro -> AddPhotonKilled();
+	}
+}
+
+//////////////////////////////////////////////////
+//   Summary histograms
+//////////////////////////////////////////////////
+void SteAct::FillSummary(const G4Step* step, G4int nPhotons)
+{
+	const G4StepPoint* prePoint = step -> GetPreStepPoint();
+	if ( prePoint -> GetPhysicalVolume() != m_SciPV ) return;
+	const G4AffineTransform& toLocal = prePoint -> GetTouchable() -> GetHistory() -> GetTopTransform();
+
+	// A counted photon (nPhotons < 0): where it was made
+	if ( nPhotons < 0 )
+	{
+		m_HisOriginZ -> Fill(toLocal.TransformPoint(step -> GetTrack() -> GetVertexPosition()).z() / mm);
+		return;
+	}
+
+	// Any other step: energy deposit, and photons it would have made in
+	// yield mode, at the middle of the step
+	G4double eDep = step -> GetTotalEnergyDeposit();
+	if ( eDep <= 0. && nPhotons == 0 ) return;
+	G4double z = toLocal.TransformPoint(0.5 * (prePoint -> GetPosition() + step -> GetPostStepPoint() -> GetPosition())).z() / mm;
+	if ( eDep > 0. ) m_HisEdepZ -> Fill(z, eDep / MeV);
+	if ( nPhotons > 0 ) m_HisOriginZ -> Fill(z, nPhotons);
+}
+
+//////////////////////////////////////////////////
+//   Calibration of optical response map
+//////////////////////////////////////////////////
+void SteAct::Calibrate(const G4Step* step)
+{
+	G4Track* track = step -> GetTrack();
+	if ( track -> GetDefinition() != m_OptPhoton ) return;
+
+	// Only photons inside the bar matter. The ones escaping are lost.
+	const G4StepPoint* prePoint = step -> GetPreStepPoint();
+	if ( prePoint -> GetPhysicalVolume() != m_SciPV )
+	{
+		track -> SetTrackStatus(fStopAndKill);
+		if ( m_Pro ) m_Pro -> AddPhotonKilled();
+		return;
+	}
+
+	// Everything in the frame of the bar
+	const G4AffineTransform& toLocal = prePoint -> GetTouchable() -> GetHistory() -> GetTopTransform();
+	G4ThreeVector vtxPos = toLocal.TransformPoint(track -> GetVertexPosition());
+	G4ThreeVector vtxDir = toLocal.TransformAxis(track -> GetVertexMomentumDirection());
+
+	if ( track -> GetCurrentStepNumber() == 1 ) m_Cal -> AddEmitted(vtxPos.z(), vtxDir.z());
+
+	// Arrived at one of the end faces?
+	const G4StepPoint* postPoint = step -> GetPostStepPoint();
+	if ( postPoint -> GetStepStatus() != fGeomBoundary ) return;
+	G4ThreeVector postPos = toLocal.TransformPoint(postPoint -> GetPosition());
+	G4double z = postPos.z();
+	if ( std::abs(z) < m_Cal -> GetHalfZ() - 1.e-3 * mm )
+	{
+		// A side face: what the surface did to the photon, for '--optics trace'
+		if ( m_SciHalf[0] <= 0. || m_SciHalf[1] <= 0. ) return;
+		G4int axis = std::abs(postPos.x()) / m_SciHalf[0] > std::abs(postPos.y()) / m_SciHalf[1] ? 0 : 1;
+		m_Sur -> Fill(toLocal.TransformAxis(prePoint -> GetMomentumDirection()), toLocal.TransformAxis(postPoint -> GetMomentumDirection()),
+		              axis, track -> GetTrackStatus() == fStopAndKill);
+		return;
+	}
+
+	G4int end = z > 0. ? +1 : -1;
+	m_Cal -> AddDetected(vtxPos.z(), vtxDir.z(), end, postPoint -> GetLocalTime());
+	m_EA -> AddDetected(end, postPoint -> GetGlobalTime(), track -> GetWeight());
+	track -> SetTrackStatus(fStopAndKill);
+	if ( m_Pro ) m_Pro -> AddPhotonKilled();
+}
+
+//////////////////////////////////////////////////
+//   Legacy stepping action
+//////////////////////////////////////////////////
+void SteAct::LegacySteppingAction(const G4Step* step)
 {
 	// I wrote examples of some information which can be extracted from a step.
 	// Uncomment whatever you want to use.
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//   SteCos.cc
+//
+//   Definitions of SteCos class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "G4VPhysicalVolume.hh"
+#include "G4AutoLock.hh"
+
+#include "SteCos.hh"
+
+namespace
+{
+	G4Mutex costMutex = G4MUTEX_INITIALIZER;
+
+	// Merged over threads: (process, volume) -> steps, time
+	std::map<std::pair<G4String, G4String>, std::pair<G4long, G4double>> runCosts;
+}
+
+G4bool SteCos::s_Enabled = false;
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+SteCos::SteCos()
+{
+	Reset();
+}
+
+SteCos::~SteCos()
+{
+}
+
+//////////////////////////////////////////////////
+//   Switch
+//////////////////////////////////////////////////
+void SteCos::Enable()
+{
+	s_Enabled = true;
+}
+
+G4bool SteCos::IsEnabled()
+{
+	return s_Enabled;
+}
+
+//////////////////////////////////////////////////
+//   Reset
+//////////////////////////////////////////////////
+void SteCos::Reset()
+{
+	m_Costs.clear();
+	m_Last = std::chrono::steady_clock::now();
+}
+
+//////////////////////////////////////////////////
+//   Merge and print
+//////////////////////////////////////////////////
+void SteCos::MergeRun() const
+{
+	// Processes are per thread, volumes are not: names are what match.
+	G4AutoLock lock(&costMutex);
+	for ( const auto& cost: m_Costs )
+	{
+		G4String procName = cost.first.first ? cost.first.first -> GetProcessName() : "none";
+		G4String volName = cost.first.second ? cost.first.second -> GetName() : "outside";
+		auto& run = runCosts[std::make_pair(procName, volName)];
+		run.first += cost.second.nSteps;
+		run.second += cost.second.time;
+	}
+}
+
+void SteCos::PrintRun()
+{
+	G4AutoLock lock(&costMutex);
+	if ( runCosts.empty() ) return;
+
+	G4long totSteps = 0;
+	G4double totTime = 0.;
+	std::vector<std::pair<std::pair<G4String, G4String>, std::pair<G4long, G4double>>> rows(runCosts.begin(), runCosts.end());
+	for ( const auto& row: rows )
+	{
+		totSteps += row.second.first;
+		totTime += row.second.second;
+	}
+	std::sort(rows.begin(), rows.end(), [](const decltype(rows)::value_type& a, const decltype(rows)::value_type& b)
+	{
+		return a.second.second > b.second.second;
+	});
+
+	char line[160];
+	G4cout << "mCP: step cost by process and volume (all threads)" << G4endl;
+	std::snprintf(line, sizeof(line), "  %-24s %-10s %12s %6s %10s %6s %9s", "process", "volume", "steps", "%", "time [s]", "%", "ns/step");
+	G4cout << line << G4endl;
+	for ( const auto& row: rows )
+	{
+		G4long nSteps = row.second.first;
+		G4double time = row.second.second;
+		std::snprintf(line, sizeof(line), "  %-24s %-10s %12ld %6.2f %10.3f %6.2f %9.1f",
+		              row.first.first.c_str(), row.first.second.c_str(),
+		              nSteps, totSteps ? 100. * nSteps / totSteps : 0.,
+		              time, totTime > 0. ? 100. * time / totTime : 0.,
+		              nSteps ? 1.e9 * time / nSteps : 0.);
+		G4cout << line << G4endl;
+	}
+	std::snprintf(line, sizeof(line), "  %-24s %-10s %12ld %6.2f %10.3f %6.2f %9.1f", "total", "", totSteps, 100., totTime, 100.,
+	              totSteps ? 1.e9 * totTime / totSteps : 0.);
+	G4cout << line << G4endl;
+
+	runCosts.clear();
+}
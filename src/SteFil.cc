@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////
+//   SteFil.cc
+//
+//   Definitions of SteFil class's member functions.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ProcessTable.hh"
+#include "G4ProcessVector.hh"
+#include "G4VProcess.hh"
+
+#include "SteFil.hh"
+#include "FilMes.hh"
+#include "SenSD.hh"
+
+//////////////////////////////////////////////////
+//   Constructor
+//////////////////////////////////////////////////
+SteFil::SteFil()
+{
+	// Default: the good old optical photon counting in the scintillator
+	m_VolNames.push_back("SciPV");
+	m_ParNames.push_back("opticalphoton");
+	m_ScintNames.push_back("Scintillation");
+	m_CerenNames.push_back("Cerenkov");
+
+	// Photons have to get to the photosensors, if there are any.
+	m_Kill = !SenSD::IsEnabled();
+	m_Legacy = false;
+
+	m_FM = new FilMes(this);
+}
+
+//////////////////////////////////////////////////
+//   Destructor
+//////////////////////////////////////////////////
+SteFil::~SteFil()
+{
+	delete m_FM;
+}
+
+//////////////////////////////////////////////////
+//   Conditions
+//////////////////////////////////////////////////
+void SteFil::AddVolume(const G4String& name)
+{
+	m_VolNames.push_back(name);
+}
+
+void SteFil::AddParticle(const G4String& name)
+{
+	m_ParNames.push_back(name);
+}
+
+void SteFil::AddScintProcess(const G4String& name)
+{
+	m_ScintNames.push_back(name);
+}
+
+void SteFil::AddCerenProcess(const G4String& name)
+{
+	m_CerenNames.push_back(name);
+}
+
+void SteFil::Reset()
+{
+	m_VolNames.clear();
+	m_ParNames.clear();
+	m_ScintNames.clear();
+	m_CerenNames.clear();
+}
+
+void SteFil::List() const
+{
+	G4cout << "SteFil conditions:" << G4endl;
+	G4cout << "  Volumes  :"; for ( const auto& n: m_VolNames   ) G4cout << " " << n; G4cout << G4endl;
+	G4cout << "  Particles:"; for ( const auto& n: m_ParNames   ) G4cout << " " << n; G4cout << G4endl;
+	G4cout << "  nScint by:"; for ( const auto& n: m_ScintNames ) G4cout << " " << n; G4cout << G4endl;
+	G4cout << "  nCeren by:"; for ( const auto& n: m_CerenNames ) G4cout << " " << n; G4cout << G4endl;
+	G4cout << "  Kill     : " << ( m_Kill ? "true" : "false" ) << G4endl;
+}
+
+void SteFil::SetKill(G4bool kill)
+{
+	m_Kill = kill;
+}
+
+G4bool SteFil::GetKill() const
+{
+	return m_Kill;
+}
+
+void SteFil::SetLegacy(G4bool legacy)
+{
+	m_Legacy = legacy;
+}
+
+G4bool SteFil::GetLegacy() const
+{
+	return m_Legacy;
+}
+
+//////////////////////////////////////////////////
+//   Resolve names to pointers
+//////////////////////////////////////////////////
+void SteFil::Resolve()
+{
+	m_Vols.clear();
+	m_Pars.clear();
+	m_ScintProcs.clear();
+	m_CerenProcs.clear();
+
+	// Volumes: several placements may share a name.
+	G4PhysicalVolumeStore* PVS = G4PhysicalVolumeStore::GetInstance();
+	for ( const auto& name: m_VolNames )
+	{
+		std::size_t nFound = 0;
+		for ( const G4VPhysicalVolume* PV: *PVS )
+		{
+			if ( PV -> GetName() != name ) continue;
+			m_Vols.push_back(PV);
+			nFound++;
+		}
+		if ( nFound == 0 )
+		{
+			G4ExceptionDescription ed;
+			ed << "Volume " << name << " is not found. Ignored.";
+			G4Exception("mCP::SteFil", "mCP002", JustWarning, ed);
+		}
+	}
+
+	// Particles
+	G4ParticleTable* PT = G4ParticleTable::GetParticleTable();
+	for ( const auto& name: m_ParNames )
+	{
+		const G4ParticleDefinition* par = PT -> FindParticle(name);
+		if ( par ) m_Pars.push_back(par);
+		else
+		{
+			G4ExceptionDescription ed;
+			ed << "Particle " << name << " is not found. Ignored.";
+			G4Exception("mCP::SteFil", "mCP002", JustWarning, ed);
+		}
+	}
+
+	// Processes: one instance is usually shared by all particles, but collect
+	// every instance anyway. The process table is thread local.
+	G4ProcessTable* PrT = G4ProcessTable::GetProcessTable();
+	auto resolveProcs = [PrT](const std::vector<G4String>& names, std::vector<const G4VProcess*>& procs)
+	{
+		for ( const auto& name: names )
+		{
+			G4ProcessVector* PV = PrT -> FindProcesses(name);
+			for ( std::size_t i = 0; i < PV -> size(); i++ )
+			{
+				const G4VProcess* proc = (*PV)[i];
+				if ( !Contains(procs, proc) ) procs.push_back(proc);
+			}
+			if ( PV -> size() == 0 )
+			{
+				G4ExceptionDescription ed;
+				ed << "Process " << name << " is not found. Ignored.";
+				G4Exception("mCP::SteFil", "mCP002", JustWarning, ed);
+			}
+			delete PV;
+		}
+	};
+	resolveProcs(m_ScintNames, m_ScintProcs);
+	resolveProcs(m_CerenNames, m_CerenProcs);
+}
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////////
+//   SurTab.cc
+//
+//   Definitions of SurTab class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "G4AutoLock.hh"
+
+#include "SurTab.hh"
+#include "OptMap.hh"
+
+namespace
+{
+	G4Mutex calibMutex = G4MUTEX_INITIALIZER;
+
+	// Shared table of trace mode and accumulated table of calibration mode
+	SurTab* sharedTab = 0;
+	SurTab* calibTab = 0;
+
+	// Table file format version. Bump it whenever the binning changes.
+	const char* tabMagic = "mCPSurTab v1";
+}
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+SurTab::SurTab()
+{
+}
+
+SurTab::~SurTab()
+{
+}
+
+//////////////////////////////////////////////////
+//   Book
+//////////////////////////////////////////////////
+void SurTab::Book(const G4String& key)
+{
+	m_Key = key;
+
+	m_NHit  .assign(s_NIn, 0.);
+	m_NRefl .assign(s_NIn, 0.);
+	m_NTrans.assign(s_NIn, 0.);
+	m_NDir  .assign(s_NIn * s_NCos * s_NPhi, 0.);
+	m_PRefl .clear();
+	m_PTrans.clear();
+	m_DirCDF.clear();
+}
+
+//////////////////////////////////////////////////
+//   Fill and merge
+//////////////////////////////////////////////////
+void SurTab::Fill(const G4ThreeVector& in, const G4ThreeVector& out, G4int axis, G4bool absorbed)
+{
+	G4ThreeVector n, e1, e2;
+	Frame(in, axis, n, e1, e2);
+	G4int bin = InBin(in.dot(n));
+	m_NHit[bin] += 1.;
+	if ( absorbed ) return;
+
+	// Still going out: it left the bar.
+	G4double cosOut = -out.dot(n);
+	if ( cosOut <= 0. )
+	{
+		m_NTrans[bin] += 1.;
+		return;
+	}
+
+	m_NRefl[bin] += 1.;
+	G4double phi = std::abs(std::atan2(out.dot(e2), out.dot(e1)));
+	G4int ic = std::min(static_cast<G4int>(cosOut * s_NCos), s_NCos - 1);
+	G4int ip = std::min(static_cast<G4int>(phi / CLHEP::pi * s_NPhi), s_NPhi - 1);
+	m_NDir[(bin * s_NCos + ic) * s_NPhi + ip] += 1.;
+}
+
+void SurTab::Merge(const SurTab& other)
+{
+	if ( !IsBooked() ) Book(other.m_Key);
+	if ( other.m_Key != m_Key ) return;
+
+	for ( G4int i = 0; i < s_NIn; i++ )
+	{
+		m_NHit  [i] += other.m_NHit  [i];
+		m_NRefl [i] += other.m_NRefl [i];
+		m_NTrans[i] += other.m_NTrans[i];
+	}
+	for ( std::size_t i = 0; i < m_NDir.size(); i++ ) m_NDir[i] += other.m_NDir[i];
+}
+
+//////////////////////////////////////////////////
+//   Finalize
+//////////////////////////////////////////////////
+void SurTab::Finalize()
+{
+	const G4int nCells = s_NCos * s_NPhi;
+	m_PRefl .assign(s_NIn, 0.f);
+	m_PTrans.assign(s_NIn, 0.f);
+	m_DirCDF.assign(s_NIn * nCells, 1.f);
+
+	for ( G4int in = 0; in < s_NIn; in++ )
+	{
+		// Angles never seen in calibration take the nearest one seen.
+		G4int from = -1;
+		for ( G4int d = 0; d < s_NIn && from < 0; d++ )
+		{
+			if      ( in - d >= 0    && m_NHit[in - d] > 0. ) from = in - d;
+			else if ( in + d < s_NIn && m_NHit[in + d] > 0. ) from = in + d;
+		}
+		if ( from < 0 ) continue;
+
+		m_PRefl [in] = m_NRefl [from] / m_NHit[from];
+		m_PTrans[in] = m_NTrans[from] / m_NHit[from];
+		if ( m_NRefl[from] <= 0. ) continue;
+
+		G4double sum = 0.;
+		for ( G4int cell = 0; cell < nCells; cell++ )
+		{
+			sum += m_NDir[from * nCells + cell];
+			m_DirCDF[in * nCells + cell] = sum / m_NRefl[from];
+		}
+	}
+}
+
+//////////////////////////////////////////////////
+//   Save and load
+//////////////////////////////////////////////////
+G4bool SurTab::Save(const G4String& fileName) const
+{
+	// Write to a temporary file and move it, as OptMap does
+	G4String tmpName = fileName + ".tmp";
+	std::ofstream file(tmpName, std::ios::binary);
+	if ( !file ) return false;
+
+	std::uint32_t keyLength = m_Key.size();
+	std::int32_t nIn = s_NIn, nCos = s_NCos, nPhi = s_NPhi;
+	file.write(tabMagic, std::strlen(tabMagic) + 1);
+	file.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+	file.write(m_Key.data(), keyLength);
+	file.write(reinterpret_cast<const char*>(&nIn ), sizeof(nIn ));
+	file.write(reinterpret_cast<const char*>(&nCos), sizeof(nCos));
+	file.write(reinterpret_cast<const char*>(&nPhi), sizeof(nPhi));
+	file.write(reinterpret_cast<const char*>(m_NHit  .data()), m_NHit  .size() * sizeof(G4double));
+	file.write(reinterpret_cast<const char*>(m_NRefl .data()), m_NRefl .size() * sizeof(G4double));
+	file.write(reinterpret_cast<const char*>(m_NTrans.data()), m_NTrans.size() * sizeof(G4double));
+	file.write(reinterpret_cast<const char*>(m_NDir  .data()), m_NDir  .size() * sizeof(G4double));
+	file.close();
+	if ( !file ) return false;
+
+	return std::rename(tmpName.c_str(), fileName.c_str()) == 0;
+}
+
+G4bool SurTab::Load(const G4String& fileName, const G4String& key)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if ( !file ) return false;
+
+	std::vector<char> magic(std::strlen(tabMagic) + 1);
+	file.read(magic.data(), magic.size());
+	if ( !file || std::string(magic.data()) != tabMagic ) return false;
+
+	std::uint32_t keyLength = 0;
+	file.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength));
+	std::string fileKey(keyLength, ' ');
+	file.read(&fileKey[0], keyLength);
+	if ( !file || fileKey != key ) return false;
+
+	std::int32_t nIn = 0, nCos = 0, nPhi = 0;
+	file.read(reinterpret_cast<char*>(&nIn ), sizeof(nIn ));
+	file.read(reinterpret_cast<char*>(&nCos), sizeof(nCos));
+	file.read(reinterpret_cast<char*>(&nPhi), sizeof(nPhi));
+	if ( !file || nIn != s_NIn || nCos != s_NCos || nPhi != s_NPhi ) return false;
+
+	Book(key);
+	file.read(reinterpret_cast<char*>(m_NHit  .data()), m_NHit  .size() * sizeof(G4double));
+	file.read(reinterpret_cast<char*>(m_NRefl .data()), m_NRefl .size() * sizeof(G4double));
+	file.read(reinterpret_cast<char*>(m_NTrans.data()), m_NTrans.size() * sizeof(G4double));
+	file.read(reinterpret_cast<char*>(m_NDir  .data()), m_NDir  .size() * sizeof(G4double));
+	if ( !file )
+	{
+		m_Key = "";
+		return false;
+	}
+
+	Finalize();
+	return true;
+}
+
+//////////////////////////////////////////////////
+//   Trace mode
+//////////////////////////////////////////////////
+void SurTab::LoadShared()
+{
+	G4double halfZ = 0.;
+	G4String key = OptMap::ComputeKey(halfZ);
+
+	// Same bar as the last run: nothing to do
+	if ( sharedTab && sharedTab -> GetKey() == key ) return;
+
+	delete sharedTab;
+	sharedTab = 0;
+
+	G4String fileName = OptMap::FileName(key, "surtab");
+	SurTab* tab = new SurTab();
+	if ( key.empty() || !tab -> Load(fileName, key) )
+	{
+		delete tab;
+		G4ExceptionDescription ed;
+		ed << "No surface table for this geometry (" << fileName << ")." << G4endl
+		   << "Run once with '--optics calib' to make one. Photons are tracked in full until then.";
+		G4Exception("mCP::SurTab", "mCP016", JustWarning, ed);
+		return;
+	}
+
+	G4cout << "mCP: surface table " << fileName << G4endl;
+	sharedTab = tab;
+}
+
+const SurTab* SurTab::GetShared()
+{
+	return sharedTab;
+}
+
+//////////////////////////////////////////////////
+//   Calibration mode
+//////////////////////////////////////////////////
+void SurTab::MergeCalibration(const SurTab& threadTab)
+{
+	if ( !threadTab.IsBooked() ) return;
+
+	G4AutoLock lock(&calibMutex);
+	if ( !calibTab ) calibTab = new SurTab();
+	if ( calibTab -> IsBooked() && calibTab -> GetKey() != threadTab.GetKey() ) calibTab -> Book(threadTab.GetKey());
+	calibTab -> Merge(threadTab);
+}
+
+void SurTab::SaveCalibration()
+{
+	G4AutoLock lock(&calibMutex);
+	if ( !calibTab || !calibTab -> IsBooked() ) return;
+
+	// Statistics of earlier calibrations of the same bar are kept.
+	G4String fileName = OptMap::FileName(calibTab -> GetKey(), "surtab");
+	SurTab previous;
+	if ( previous.Load(fileName, calibTab -> GetKey()) ) calibTab -> Merge(previous);
+
+	if ( calibTab -> Save(fileName) ) G4cout << "mCP: surface table saved to " << fileName << G4endl;
+	else
+	{
+		G4ExceptionDescription ed;
+		ed << "Failed to write " << fileName << ".";
+		G4Exception("mCP::SurTab", "mCP016", JustWarning, ed);
+	}
+
+	delete calibTab;
+	calibTab = 0;
+}
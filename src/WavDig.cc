@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//   WavDig.cc
+//
+//   Definitions of WavDig class's member functions.
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include "WavDig.hh"
+#include "DigMes.hh"
+#include "RunAct.hh"
+
+//////////////////////////////////////////////////
+//   Constructor and destructor
+//////////////////////////////////////////////////
+WavDig::WavDig()
+{
+	// 5 GS/s over 200 ns, and a fast SiPM-like pulse
+	m_Dt = 0.2 * ns;
+	m_T0 = 0. * ns;
+	m_Window = 200. * ns;
+	m_Rise = 1. * ns;
+	m_Fall = 10. * ns;
+	m_SPEAmp = 1.;  // mV
+	m_Noise = 0.1;  // mV
+	m_Thr = 2.5;    // mV
+	m_CFD = 0.2;
+	m_Dirty = true;
+
+	m_DM = new DigMes(this);
+}
+
+WavDig::~WavDig()
+{
+	delete m_DM;
+}
+
+//////////////////////////////////////////////////
+//   Columns
+//////////////////////////////////////////////////
+void WavDig::AddColumns()
+{
+	// EveAct relies on this order.
+	RunAct::AddColumn("ampPz" , 'D'); // mV
+	RunAct::AddColumn("ampMz" , 'D');
+	RunAct::AddColumn("tThrPz", 'D'); // ns
+	RunAct::AddColumn("tThrMz", 'D');
+	RunAct::AddColumn("tCfdPz", 'D'); // ns
+	RunAct::AddColumn("tCfdMz", 'D');
+}
+
+//////////////////////////////////////////////////
+//   Template and buffers
+//////////////////////////////////////////////////
+void WavDig::Prepare()
+{
+	if ( !m_Dirty ) return;
+	m_Dirty = false;
+
+	std::size_t nSamples = std::max<G4int>(2, G4int(m_Window / m_Dt));
+	m_Counts.assign(nSamples, 0.f);
+	m_Wave.assign(nSamples, 0.f);
+	m_Rand.assign(nSamples, 0.);
+
+	// exp(-t/fall) - exp(-t/rise), scaled to peak at the SPE amplitude, and
+	// long enough for the tail to fall below 1e-3 of the peak
+	G4double rise = std::max(m_Rise, 1.e-3 * ns);
+	G4double fall = std::max(m_Fall, rise * 1.001);
+	G4double tPeak = std::log(fall / rise) * rise * fall / (fall - rise);
+	G4double peak = std::exp(-tPeak / fall) - std::exp(-tPeak / rise);
+	std::size_t length = std::min<std::size_t>(nSamples, std::size_t((tPeak + fall * std::log(1.e3)) / m_Dt) + 1);
+	m_Template.resize(length);
+	for ( std::size_t k = 0; k < length; k++ )
+	{
+		G4double t = k * m_Dt;
+		m_Template[k] = m_SPEAmp * (std::exp(-t / fall) - std::exp(-t / rise)) / peak;
+	}
+}
+
+//////////////////////////////////////////////////
+//   Digitize
+//////////////////////////////////////////////////
+void WavDig::Digitize(const std::vector<G4double>& times, G4double& amp, G4double& tThr, G4double& tCfd)
+{
+	Prepare();
+	const std::size_t n = m_Wave.size();
+	const std::size_t length = m_Template.size();
+	float* counts = m_Counts.data();
+	float* wave = m_Wave.data();
+	const float* tmpl = m_Template.data();
+
+	// Binning: every photon is shared by the two samples around it, which
+	// keeps its timing finer than a sample.
+	std::fill(m_Counts.begin(), m_Counts.end(), 0.f);
+	const G4double invDt = 1. / m_Dt;
+	const G4double last = n - 1;
+	for ( G4double t: times )
+	{
+		G4double x = (t - m_T0) * invDt;
+		if ( x < 0. || x >= last ) continue;
+		std::size_t i = std::size_t(x);
+		float f = x - i;
+		counts[i] += 1.f - f;
+		counts[i + 1] += f;
+	}
+
+	// Convolution: the template once per non-empty sample
+	std::fill(m_Wave.begin(), m_Wave.end(), 0.f);
+	for ( std::size_t i = 0; i < n; i++ )
+	{
+		const float c = counts[i];
+		if ( c == 0.f ) continue;
+		const std::size_t m = std::min(length, n - i);
+		float* w = wave + i;
+		for ( std::size_t k = 0; k < m; k++ ) w[k] += c * tmpl[k];
+	}
+
+	// Noise
+	if ( m_Noise > 0. )
+	{
+		G4RandGauss::shootArray(n, m_Rand.data(), 0., m_Noise);
+		for ( std::size_t i = 0; i < n; i++ ) wave[i] += m_Rand[i];
+	}
+
+	// Peak
+	std::size_t iMax = std::max_element(m_Wave.begin(), m_Wave.end()) - m_Wave.begin();
+	amp = wave[iMax];
+	tThr = tCfd = -1.;
+	if ( amp < m_Thr ) return;
+
+	// Leading edge crossing of a level, interpolated between samples
+	auto crossing = [&](std::size_t i, G4double level)
+	{
+		if ( i == 0 ) return m_T0;
+		G4double f = (level - wave[i - 1]) / (wave[i] - wave[i - 1]);
+		return m_T0 + (i - 1 + f) * m_Dt;
+	};
+
+	// Threshold: first sample above it
+	std::size_t i = 0;
+	while ( wave[i] < m_Thr ) i++;
+	tThr = crossing(i, m_Thr);
+
+	// CFD: going back from the peak, the first sample below the fraction
+	G4double level = m_CFD * amp;
+	std::size_t j = iMax;
+	while ( j > 0 && wave[j - 1] >= level ) j--;
+	tCfd = crossing(j, level);
+}
+
+//////////////////////////////////////////////////
+//   Print
+//////////////////////////////////////////////////
+void WavDig::Print() const
+{
+	G4cout << "WavDig settings:" << G4endl;
+	G4cout << "  Sampling : " << m_Dt / ns << " ns from " << m_T0 / ns << " ns over " << m_Window / ns << " ns" << G4endl;
+	G4cout << "  Template : rise " << m_Rise / ns << " ns, fall " << m_Fall / ns << " ns, SPE " << m_SPEAmp << " mV" << G4endl;
+	G4cout << "  Noise    : " << m_Noise << " mV" << G4endl;
+	G4cout << "  Threshold: " << m_Thr << " mV, CFD fraction " << m_CFD << G4endl;
+}
@@ -0,0 +1,309 @@
+#ifndef COLREA_h
+#define COLREA_h 1
+
+////////////////////////////////////////////////////////////////////////////////
+//   ColRea.hh
+//
+//   This file is a header-only reader of mCP columnar output (ColFmt.hh). The
+// file is memory-mapped, and blocks and columns are read in place: nothing is
+// copied or unpacked until a value is asked for.
+//
+//   ColRea reader("mCP_..._t0.mcpcol");
+//   int col = reader.FindColumn("nScint");
+//   reader.ForEach(col, [](std::int64_t row, double value) { ... });
+//
+//   No Geant4 needed, only POSIX.
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ColFmt.hh"
+
+class ColRea
+{
+  public:
+	struct Column
+	{
+		std::string name;
+		char type; // 'I' or 'D'
+	};
+
+	// A block of rows. Values point into the mapped file.
+	class Block
+	{
+	  public:
+		std::uint32_t GetNRows() const { return m_NRows; }
+
+		inline std::int64_t GetI(std::size_t col, std::uint32_t row) const;
+		inline double GetD(std::size_t col, std::uint32_t row) const;
+
+		// Raw view: 'I' values are reference + unsigned offsets of width
+		// bytes, 'D' values are doubles.
+		const void* GetData(std::size_t col) const { return m_Data[col]; }
+		unsigned GetWidth(std::size_t col) const { return m_Width[col]; }
+		std::int64_t GetReference(std::size_t col) const { return m_Reference[col]; }
+
+	  private:
+		friend class ColRea;
+		std::uint32_t m_NRows;
+		std::vector<const unsigned char*> m_Data;
+		std::vector<unsigned> m_Width;
+		std::vector<std::int64_t> m_Reference;
+		std::vector<char> m_Type;
+	};
+
+	explicit ColRea(const std::string& fileName);
+	~ColRea();
+	ColRea(const ColRea&) = delete;
+	ColRea& operator=(const ColRea&) = delete;
+
+	bool IsOpen() const { return m_Map != 0; }
+	const std::string& GetError() const { return m_Error; }
+
+	// A job killed in the middle leaves a partial block at the end. It is
+	// skipped, and this tells.
+	bool IsTruncated() const { return m_Truncated; }
+
+	const std::vector<Column>& GetColumns() const { return m_Columns; }
+	const std::vector<std::pair<std::string, std::string>>& GetMeta() const { return m_Meta; }
+	int FindColumn(const std::string& name) const;
+
+	std::size_t GetNBlocks() const { return m_Blocks.size(); }
+	const Block& GetBlock(std::size_t i) const { return m_Blocks[i]; }
+	std::uint64_t GetNRows() const { return m_NRows; }
+
+	// Every value of a column as f(row, value), block after block
+	template <class F> void ForEach(std::size_t col, F f) const;
+
+  private:
+	bool Parse();
+
+  private:
+	const unsigned char* m_Map;
+	std::size_t m_Size;
+	std::string m_Error;
+	bool m_Truncated;
+
+	std::vector<Column> m_Columns;
+	std::vector<std::pair<std::string, std::string>> m_Meta;
+	std::vector<Block> m_Blocks;
+	std::uint64_t m_NRows;
+};
+
+//////////////////////////////////////////////////
+//   Block values
+//////////////////////////////////////////////////
+inline std::int64_t ColRea::Block::GetI(std::size_t col, std::uint32_t row) const
+{
+	const unsigned char* p = m_Data[col];
+	switch ( m_Width[col] )
+	{
+		case 0 : return m_Reference[col];
+		case 1 : return m_Reference[col] + reinterpret_cast<const std::uint8_t *>(p)[row];
+		case 2 : return m_Reference[col] + reinterpret_cast<const std::uint16_t*>(p)[row];
+		case 4 : return m_Reference[col] + reinterpret_cast<const std::uint32_t*>(p)[row];
+		default: return m_Reference[col] + static_cast<std::int64_t>(reinterpret_cast<const std::uint64_t*>(p)[row]);
+	}
+}
+
+inline double ColRea::Block::GetD(std::size_t col, std::uint32_t row) const
+{
+	if ( m_Type[col] == 'I' ) return static_cast<double>(GetI(col, row));
+	return reinterpret_cast<const double*>(m_Data[col])[row];
+}
+
+template <class F>
+void ColRea::ForEach(std::size_t col, F f) const
+{
+	std::int64_t row = 0;
+	for ( const Block& block: m_Blocks )
+		for ( std::uint32_t i = 0; i < block.m_NRows; i++ )
+			f(row++, block.GetD(col, i));
+}
+
+//////////////////////////////////////////////////
+//   Open and close
+//////////////////////////////////////////////////
+inline ColRea::ColRea(const std::string& fileName)
+{
+	m_Map = 0;
+	m_Size = 0;
+	m_Truncated = false;
+	m_NRows = 0;
+
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if ( fd < 0 )
+	{
+		m_Error = "cannot open " + fileName;
+		return;
+	}
+
+	struct stat st;
+	if ( fstat(fd, &st) == 0 && st.st_size > 0 )
+	{
+		void* map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if ( map != MAP_FAILED )
+		{
+			m_Map = static_cast<const unsigned char*>(map);
+			m_Size = st.st_size;
+			madvise(map, m_Size, MADV_SEQUENTIAL);
+		}
+	}
+	close(fd);
+
+	if ( !m_Map ) m_Error = "cannot map " + fileName;
+	else if ( !Parse() )
+	{
+		munmap(const_cast<unsigned char*>(m_Map), m_Size);
+		m_Map = 0;
+		m_Error = fileName + ": " + m_Error;
+	}
+}
+
+inline ColRea::~ColRea()
+{
+	if ( m_Map ) munmap(const_cast<unsigned char*>(m_Map), m_Size);
+}
+
+inline int ColRea::FindColumn(const std::string& name) const
+{
+	for ( std::size_t i = 0; i < m_Columns.size(); i++ )
+		if ( m_Columns[i].name == name ) return i;
+
+	return -1;
+}
+
+//////////////////////////////////////////////////
+//   Parse header and index blocks
+//////////////////////////////////////////////////
+inline bool ColRea::Parse()
+{
+	std::size_t pos = 0;
+	auto has = [&](std::size_t n) { return pos + n <= m_Size; };
+	auto get = [&](void* dst, std::size_t n) { std::memcpy(dst, m_Map + pos, n); pos += n; };
+
+	if ( !has(sizeof(ColFmt::Magic) + 4) || std::memcmp(m_Map, ColFmt::Magic, sizeof(ColFmt::Magic)) != 0 )
+	{
+		m_Error = "not an mCP columnar file";
+		return false;
+	}
+	pos = sizeof(ColFmt::Magic);
+
+	std::uint32_t headerSize;
+	get(&headerSize, 4);
+	const std::size_t firstBlock = pos + headerSize;
+	if ( firstBlock > m_Size )
+	{
+		m_Error = "truncated header";
+		return false;
+	}
+
+	// Counts and lengths come from the file, so every read is checked
+	// against the end of the header, and the counts against what it can
+	// hold: a column takes 2 bytes at least, a metadata entry 4.
+	auto inHeader = [&](std::size_t n) { return pos + n <= firstBlock; };
+	auto corrupt = [&]() { m_Error = "corrupt header"; return false; };
+
+	// Columns
+	std::uint32_t nColumns;
+	if ( !inHeader(4) ) return corrupt();
+	get(&nColumns, 4);
+	if ( nColumns > (firstBlock - pos) / 2 ) return corrupt();
+	for ( std::uint32_t i = 0; i < nColumns; i++ )
+	{
+		std::uint8_t type, nameLength;
+		if ( !inHeader(2) ) return corrupt();
+		get(&type, 1);
+		get(&nameLength, 1);
+		if ( ( type != 'I' && type != 'D' ) || !inHeader(nameLength) ) return corrupt();
+		Column col;
+		col.type = type;
+		col.name.assign(reinterpret_cast<const char*>(m_Map + pos), nameLength);
+		pos += nameLength;
+		m_Columns.push_back(col);
+	}
+
+	// Metadata
+	std::uint32_t nMeta;
+	if ( !inHeader(4) ) return corrupt();
+	get(&nMeta, 4);
+	if ( nMeta > (firstBlock - pos) / 4 ) return corrupt();
+	for ( std::uint32_t i = 0; i < nMeta; i++ )
+	{
+		std::uint16_t length;
+		if ( !inHeader(2) ) return corrupt();
+		get(&length, 2);
+		if ( !inHeader(length) ) return corrupt();
+		std::string key(reinterpret_cast<const char*>(m_Map + pos), length);
+		pos += length;
+		if ( !inHeader(2) ) return corrupt();
+		get(&length, 2);
+		if ( !inHeader(length) ) return corrupt();
+		std::string value(reinterpret_cast<const char*>(m_Map + pos), length);
+		pos += length;
+		m_Meta.push_back(std::make_pair(key, value));
+	}
+
+	// Blocks: only their headers are touched here.
+	pos = firstBlock;
+	while ( pos < m_Size )
+	{
+		std::uint32_t magic, nRows;
+		if ( !has(8) ) { m_Truncated = true; break; }
+		get(&magic, 4);
+		get(&nRows, 4);
+		if ( magic != ColFmt::BlockMagic )
+		{
+			m_Error = "corrupt block";
+			return false;
+		}
+
+		Block block;
+		block.m_NRows = nRows;
+		bool complete = true;
+		for ( const Column& col: m_Columns )
+		{
+			if ( !has(16) ) { complete = false; break; }
+			std::int64_t reference;
+			std::memcpy(&reference, m_Map + pos, 8);
+			unsigned width = m_Map[pos + 8];
+			pos += 16;
+
+			// The width decides how far the next column is, so a bad one is
+			// not skipped over.
+			bool valid = col.type == 'D' ? width == 8 : ( width == 0 || width == 1 || width == 2 || width == 4 || width == 8 );
+			if ( !valid )
+			{
+				m_Error = "corrupt block";
+				return false;
+			}
+
+			std::size_t size = ColFmt::Pad8(static_cast<std::size_t>(nRows) * width);
+			if ( !has(size) ) { complete = false; break; }
+			block.m_Data.push_back(m_Map + pos);
+			block.m_Width.push_back(width);
+			block.m_Reference.push_back(reference);
+			block.m_Type.push_back(col.type);
+			pos += size;
+		}
+		if ( !complete ) { m_Truncated = true; break; }
+
+		m_NRows += nRows;
+		m_Blocks.push_back(block);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//   mcpcol.cc
+//
+//   Command line reader of mCP columnar output. Prints metadata, columns and
+// simple statistics of one or more files (e.g. the files of all worker
+// threads or shards of a job), or dumps their rows as CSV.
+//
+//   mcpcol mCP_2026-10-16_12-00-00_t*.mcpcol
+//   mcpcol -c mCP_2026-10-16_12-00-00.mcpcol > rows.csv
+//
+//                       - 16. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "ColRea.hh"
+
+//////////////////////////////////////////////////
+//   Main function                              //
+//////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+	int flag_c = 0;
+	int option;
+	while ( (option = getopt(argc, argv, "ch")) != -1 )
+	{
+		switch ( option )
+		{
+			case 'c' :
+				flag_c = 1;
+				break;
+			default :
+				std::cout << "usage: mcpcol [-c] file.mcpcol ..." << std::endl;
+				std::cout << "  -c  Dump rows as CSV instead of statistics" << std::endl;
+				return option == 'h' ? 0 : 1;
+		}
+	}
+	if ( optind >= argc )
+	{
+		std::cout << "usage: mcpcol [-c] file.mcpcol ..." << std::endl;
+		return 1;
+	}
+
+	// Open everything first: all files must have the same columns.
+	std::vector<std::unique_ptr<ColRea>> readers;
+	for ( int i = optind; i < argc; i++ )
+	{
+		readers.emplace_back(new ColRea(argv[i]));
+		const ColRea& reader = *readers.back();
+		if ( !reader.IsOpen() )
+		{
+			std::cerr << "mcpcol: " << reader.GetError() << std::endl;
+			return 1;
+		}
+		if ( reader.IsTruncated() ) std::cerr << "mcpcol: " << argv[i] << " is truncated, last block skipped" << std::endl;
+
+		const auto& cols = reader.GetColumns();
+		const auto& first = readers.front() -> GetColumns();
+		bool same = cols.size() == first.size();
+		for ( std::size_t c = 0; same && c < cols.size(); c++ )
+			same = cols[c].name == first[c].name && cols[c].type == first[c].type;
+		if ( !same )
+		{
+			std::cerr << "mcpcol: " << argv[i] << " has other columns than " << argv[optind] << std::endl;
+			return 1;
+		}
+	}
+	const auto& columns = readers.front() -> GetColumns();
+
+	// CSV
+	if ( flag_c )
+	{
+		for ( std::size_t c = 0; c < columns.size(); c++ )
+			std::printf("%s%s", c ? "," : "", columns[c].name.c_str());
+		std::printf("\n");
+
+		for ( const auto& reader: readers )
+		{
+			for ( std::size_t b = 0; b < reader -> GetNBlocks(); b++ )
+			{
+				const ColRea::Block& block = reader -> GetBlock(b);
+				for ( std::uint32_t row = 0; row < block.GetNRows(); row++ )
+				{
+					for ( std::size_t c = 0; c < columns.size(); c++ )
+					{
+						if ( c ) std::printf(",");
+						if ( columns[c].type == 'I' ) std::printf("%lld", static_cast<long long>(block.GetI(c, row)));
+						else                          std::printf("%.9g", block.GetD(c, row));
+					}
+					std::printf("\n");
+				}
+			}
+		}
+		return 0;
+	}
+
+	// Metadata of every file
+	std::uint64_t nRows = 0;
+	for ( std::size_t i = 0; i < readers.size(); i++ )
+	{
+		const ColRea& reader = *readers[i];
+		std::cout << argv[optind + i] << ": " << reader.GetNRows() << " rows in " << reader.GetNBlocks() << " blocks" << std::endl;
+		for ( const auto& meta: reader.GetMeta() )
+			std::cout << "  " << meta.first << " = " << meta.second << std::endl;
+		nRows += reader.GetNRows();
+	}
+
+	// Statistics of every column over all files
+	std::cout << std::endl;
+	std::printf("%-12s %4s %14s %14s %14s %14s\n", "column", "type", "min", "max", "mean", "rms");
+	for ( std::size_t c = 0; c < columns.size(); c++ )
+	{
+		double min = std::numeric_limits<double>::infinity(), max = -min;
+		double sum = 0., sum2 = 0.;
+		for ( const auto& reader: readers )
+		{
+			reader -> ForEach(c, [&](std::int64_t, double value)
+			{
+				if ( value < min ) min = value;
+				if ( value > max ) max = value;
+				sum += value;
+				sum2 += value * value;
+			});
+		}
+		double mean = nRows ? sum / nRows : 0.;
+		double rms = nRows ? std::sqrt(std::max(sum2 / nRows - mean * mean, 0.)) : 0.;
+		std::printf("%-12s %4c %14.6g %14.6g %14.6g %14.6g\n", columns[c].name.c_str(), columns[c].type, min, max, mean, rms);
+	}
+	std::cout << nRows << " rows" << std::endl;
+
+	return 0;
+}
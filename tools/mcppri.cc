@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+//   mcppri.cc
+//
+//   Converter of primary particles to the input format of mCP '--primaries'
+// (PriFmt.hh), and its reader. Input is text, one primary per line:
+//
+//   event pdg x y z t px py pz     (mm, ns, MeV; '#' starts a comment)
+//
+// Lines of an event are together and event numbers increase; an input that
+// goes back is rejected. Every new event number starts a new entry, so
+// entries are counted from 0 whatever the gaps between event numbers. Text
+// is streamed, so inputs of any size only keep the index in memory.
+//
+//   mcppri events.txt events.mcppri      Convert ('-' reads stdin)
+//   mcppri -d events.mcppri              Dump back as text
+//   mcppri -r events.mcppri              Read every primary and time it
+//
+//                       - 17. Oct. 2026. Hoyong Jeong (hoyong5419@korea.ac.kr)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "PriFmt.hh"
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cout << "usage: mcppri input.txt output.mcppri" << std::endl;
+		std::cout << "       mcppri -d file.mcppri" << std::endl;
+		std::cout << "       mcppri -r file.mcppri" << std::endl;
+		std::cout << "  Lines of input are 'event pdg x y z t px py pz' in mm, ns and MeV" << std::endl;
+		std::cout << "  Event numbers must increase; each one is the next entry" << std::endl;
+		std::cout << "  -d  Dump as text" << std::endl;
+		std::cout << "  -r  Read every primary and print the rate" << std::endl;
+	}
+
+	//////////////////////////////////////////////////
+	//   Text to primary file
+	//////////////////////////////////////////////////
+	int Convert(const char* inName, const char* outName)
+	{
+		FILE* in = std::strcmp(inName, "-") == 0 ? stdin : std::fopen(inName, "r");
+		if ( !in )
+		{
+			std::cerr << "mcppri: cannot open " << inName << std::endl;
+			return 1;
+		}
+		FILE* out = std::fopen(outName, "wb");
+		if ( !out )
+		{
+			std::cerr << "mcppri: cannot open " << outName << std::endl;
+			return 1;
+		}
+		static char outBuffer[1 << 20];
+		std::setvbuf(out, outBuffer, _IOFBF, sizeof(outBuffer));
+
+		// Header is written again at the end.
+		PriFmt::Header header;
+		std::memset(&header, 0, sizeof(header));
+		std::fwrite(&header, sizeof(header), 1, out);
+
+		std::vector<std::uint64_t> index;
+		std::uint64_t nPrimaries = 0;
+		long long lastEvent = 0;
+		long lineNumber = 0;
+		char line[4096];
+		while ( std::fgets(line, sizeof(line), in) )
+		{
+			lineNumber++;
+			char* hash = std::strchr(line, '#');
+			if ( hash ) *hash = '\0';
+
+			char* p = line;
+			char* end;
+			long long event = std::strtoll(p, &end, 10);
+			if ( end == p )
+			{
+				// Blank line
+				while ( *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' ) p++;
+				if ( *p == '\0' ) continue;
+				std::cerr << "mcppri: " << inName << ":" << lineNumber << ": bad line" << std::endl;
+				return 1;
+			}
+			p = end;
+
+			PriFmt::Record rec;
+			std::memset(&rec, 0, sizeof(rec));
+			rec.pdg = std::strtol(p, &end, 10);
+			bool ok = end != p;
+			double* values[7] = { &rec.x, &rec.y, &rec.z, &rec.t, &rec.px, &rec.py, &rec.pz };
+			for ( int i = 0; ok && i < 7; i++ )
+			{
+				p = end;
+				*values[i] = std::strtod(p, &end);
+				ok = end != p;
+			}
+			if ( !ok )
+			{
+				std::cerr << "mcppri: " << inName << ":" << lineNumber << ": needs 'event pdg x y z t px py pz'" << std::endl;
+				return 1;
+			}
+
+			// Event numbers only go up, so lines of an event cannot be split
+			// and events cannot be swapped without notice.
+			if ( !index.empty() && event < lastEvent )
+			{
+				std::cerr << "mcppri: " << inName << ":" << lineNumber << ": event " << event << " after event " << lastEvent
+				          << ". Event numbers must increase" << std::endl;
+				return 1;
+			}
+			if ( index.empty() || event != lastEvent ) index.push_back(nPrimaries);
+			lastEvent = event;
+			std::fwrite(&rec, sizeof(rec), 1, out);
+			nPrimaries++;
+		}
+		if ( in != stdin ) std::fclose(in);
+
+		// Index, and the header now that it is known
+		header.nEvents = index.size();
+		header.nPrimaries = nPrimaries;
+		header.indexPos = sizeof(header) + nPrimaries * sizeof(PriFmt::Record);
+		std::memcpy(header.magic, PriFmt::Magic, sizeof(header.magic));
+		index.push_back(nPrimaries);
+		std::fwrite(index.data(), sizeof(std::uint64_t), index.size(), out);
+		std::fseek(out, 0, SEEK_SET);
+		std::fwrite(&header, sizeof(header), 1, out);
+		if ( std::fclose(out) != 0 )
+		{
+			std::cerr << "mcppri: cannot write " << outName << std::endl;
+			return 1;
+		}
+
+		std::cout << outName << ": " << header.nEvents << " events, " << nPrimaries << " primaries" << std::endl;
+		return 0;
+	}
+
+	//////////////////////////////////////////////////
+	//   Primary file, mapped
+	//////////////////////////////////////////////////
+	struct Mapped
+	{
+		const char* map = 0;
+		std::size_t size = 0;
+		PriFmt::Header header;
+		const std::uint64_t* index = 0;
+		const PriFmt::Record* records = 0;
+	};
+
+	bool Map(const char* fileName, Mapped& file)
+	{
+		int fd = open(fileName, O_RDONLY);
+		struct stat st;
+		if ( fd < 0 || fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(PriFmt::Header)) )
+		{
+			if ( fd >= 0 ) close(fd);
+			std::cerr << "mcppri: cannot open " << fileName << std::endl;
+			return false;
+		}
+		void* map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if ( map == MAP_FAILED )
+		{
+			std::cerr << "mcppri: cannot map " << fileName << std::endl;
+			return false;
+		}
+		madvise(map, st.st_size, MADV_SEQUENTIAL);
+		file.map = static_cast<const char*>(map);
+		file.size = st.st_size;
+		std::memcpy(&file.header, file.map, sizeof(file.header));
+
+		const PriFmt::Header& h = file.header;
+		bool ok = std::memcmp(h.magic, PriFmt::Magic, sizeof(PriFmt::Magic)) == 0
+		       && h.indexPos == sizeof(h) + h.nPrimaries * sizeof(PriFmt::Record)
+		       && h.indexPos + (h.nEvents + 1) * 8 == file.size;
+		if ( !ok )
+		{
+			std::cerr << "mcppri: " << fileName << " is not a primary file, or is truncated" << std::endl;
+			return false;
+		}
+		file.index = reinterpret_cast<const std::uint64_t*>(file.map + h.indexPos);
+		file.records = reinterpret_cast<const PriFmt::Record*>(file.map + sizeof(h));
+		return true;
+	}
+}
+
+//////////////////////////////////////////////////
+//   Main function                              //
+//////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+	int flag_d = 0, flag_r = 0;
+	int option;
+	while ( (option = getopt(argc, argv, "drh")) != -1 )
+	{
+		switch ( option )
+		{
+			case 'd' :
+				flag_d = 1;
+				break;
+			case 'r' :
+				flag_r = 1;
+				break;
+			default :
+				PrintUsage();
+				return option == 'h' ? 0 : 1;
+		}
+	}
+	if ( !flag_d && !flag_r )
+	{
+		if ( argc - optind != 2 )
+		{
+			PrintUsage();
+			return 1;
+		}
+		return Convert(argv[optind], argv[optind + 1]);
+	}
+	if ( argc - optind != 1 )
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	Mapped file;
+	if ( !Map(argv[optind], file) ) return 1;
+	const std::uint64_t nEvents = file.header.nEvents;
+
+	// Text, as it came in
+	if ( flag_d )
+	{
+		for ( std::uint64_t e = 0; e < nEvents; e++ )
+		{
+			for ( std::uint64_t i = file.index[e]; i < file.index[e + 1]; i++ )
+			{
+				const PriFmt::Record& r = file.records[i];
+				std::printf("%llu %d %.9g %.9g %.9g %.9g %.9g %.9g %.9g\n", static_cast<unsigned long long>(e), r.pdg,
+				            r.x, r.y, r.z, r.t, r.px, r.py, r.pz);
+			}
+		}
+		return 0;
+	}
+
+	// Every record, event by event as mCP does
+	auto start = std::chrono::steady_clock::now();
+	double sum = 0.;
+	for ( std::uint64_t e = 0; e < nEvents; e++ )
+	{
+		for ( std::uint64_t i = file.index[e]; i < file.index[e + 1]; i++ )
+		{
+			const PriFmt::Record& r = file.records[i];
+			sum += r.pdg + r.x + r.y + r.z + r.t + r.px + r.py + r.pz;
+		}
+	}
+	double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::uint64_t nPrimaries = file.header.nPrimaries;
+	std::printf("%s: %llu events, %llu primaries, %.1f MB in %.3f s (%.3g events/s, %.3g primaries/s, checksum %g)\n",
+	            argv[optind], static_cast<unsigned long long>(nEvents), static_cast<unsigned long long>(nPrimaries),
+	            file.size / 1048576., time, nEvents / time, nPrimaries / time, sum);
+	return 0;
+}